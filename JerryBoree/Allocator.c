@@ -0,0 +1,99 @@
+#include "Allocator.h"
+
+/**
+ * @brief A slab: a header followed by the memory of its blocks.
+ */
+typedef struct slab_rec {
+    struct slab_rec *next;
+} slab_rec, *slab;
+
+struct slab_pool_rec {
+    /**
+ * @brief Structure representing a slab pool.
+ *
+ * - `freeList`: The released blocks, each holding the pointer to the next one.
+ * - `cursor` / `end`: The part of the newest slab not handed out yet.
+ * - `slabs`: All the slabs, so that they can be freed together.
+ * - `alloc`: The allocator handed to the containers, whose context is the pool itself.
+ */
+    size_t objectSize;
+    int objectsPerSlab;
+    int used;
+    Element freeList;
+    char *cursor;
+    char *end;
+    slab slabs;
+    allocator alloc;
+};
+
+static Element slab_allocate(Element context, size_t size) {
+    slab_pool pool = (slab_pool) context;
+    if (size > pool->objectSize) return malloc(size);
+    Element block = pool->freeList;
+    if (block != NULL) {
+        pool->freeList = *(Element *) block;
+    } else {
+        if (pool->cursor == pool->end) {
+            //blocks are a whole number of pointers long, so they stay aligned after the header
+            slab newSlab = (slab) malloc(sizeof(slab_rec) + pool->objectSize * pool->objectsPerSlab);
+            if (newSlab == NULL) return NULL;
+            newSlab->next = pool->slabs;
+            pool->slabs = newSlab;
+            pool->cursor = (char *) (newSlab + 1);
+            pool->end = pool->cursor + pool->objectSize * pool->objectsPerSlab;
+        }
+        block = pool->cursor;
+        pool->cursor += pool->objectSize;
+    }
+    pool->used++;
+    return block;
+}
+
+static void slab_release(Element context, Element block, size_t size) {
+    slab_pool pool = (slab_pool) context;
+    if (size > pool->objectSize) {
+        free(block);
+        return;
+    }
+    *(Element *) block = pool->freeList;
+    pool->freeList = block;
+    pool->used--;
+}
+
+slab_pool createSlabPool(size_t objectSize, int objectsPerSlab) {
+    if (objectSize == 0 || objectsPerSlab <= 0) return NULL;
+    slab_pool pool = (slab_pool) malloc(sizeof(struct slab_pool_rec));
+    if (pool == NULL) return NULL;
+    pool->objectSize = (objectSize + sizeof(Element) - 1) / sizeof(Element) * sizeof(Element);
+    pool->objectsPerSlab = objectsPerSlab;
+    pool->used = 0;
+    pool->freeList = NULL;
+    pool->cursor = NULL;
+    pool->end = NULL;
+    pool->slabs = NULL;
+    pool->alloc.allocate = slab_allocate;
+    pool->alloc.release = slab_release;
+    pool->alloc.context = pool;
+    return pool;
+}
+
+const allocator *getSlabAllocator(slab_pool pool) {
+    if (pool == NULL) return NULL;
+    return &pool->alloc;
+}
+
+int getSlabPoolUsage(slab_pool pool) {
+    if (pool == NULL) return 0;
+    return pool->used;
+}
+
+void destroySlabPool(slab_pool pool) {
+    if (pool == NULL) return;
+    slab cur = pool->slabs;
+    while (cur != NULL) {
+        slab next = cur->next;
+        free(cur);
+        cur = next;
+    }
+    free(pool);
+}
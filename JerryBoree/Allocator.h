@@ -0,0 +1,94 @@
+#ifndef ALLOCATOR_H
+#define ALLOCATOR_H
+#include "Defs.h"
+
+/**
+ * @brief A source of memory for the small objects of a data structure.
+ *
+ * The containers (`createLinkedListWithAllocator`, `createHashTableWithAllocator`,
+ * `createMultiValueHashTableWithAllocator`) take the memory of their nodes, pairs and bucket
+ * lists from an allocator instead of `malloc`. A `NULL` allocator stands for `malloc`/`free`.
+ * The allocator must outlive every structure using it.
+ *
+ * Members:
+ *   - allocate: Returns a block of at least `size` bytes, aligned for pointers, or `NULL`.
+ *   - release: Gives back a block obtained from `allocate` with the same `size`.
+ *   - context: Passed as is to both functions.
+ */
+typedef struct {
+    Element (*allocate)(Element context, size_t size);
+    void (*release)(Element context, Element block, size_t size);
+    Element context;
+} allocator;
+
+typedef struct slab_pool_rec* slab_pool;
+
+/**
+ * @brief Obtains a block from an allocator, or from `malloc` if the allocator is `NULL`.
+ */
+static inline Element allocateBlock(const allocator *alloc, size_t size) {
+    if (alloc == NULL) return malloc(size);
+    return alloc->allocate(alloc->context, size);
+}
+
+/**
+ * @brief Gives a block back to the allocator it came from, or to `free` if the allocator is `NULL`.
+ */
+static inline void releaseBlock(const allocator *alloc, Element block, size_t size) {
+    if (block == NULL) return;
+    if (alloc == NULL) {
+        free(block);
+        return;
+    }
+    alloc->release(alloc->context, block, size);
+}
+
+/**
+ * @brief Creates a pool handing out blocks of one fixed size.
+ *
+ * Blocks are cut from large slabs, each holding `objectsPerSlab` blocks, and released blocks are
+ * kept on a free list for reuse, so allocating and releasing take a few instructions and no call
+ * to `malloc`. Requests larger than the block size are passed on to `malloc`. Destroying the pool
+ * frees all its slabs at once. The pool is not thread safe.
+ *
+ * @param objectSize The size of the blocks, rounded up to a multiple of the pointer size.
+ * @param objectsPerSlab The number of blocks allocated together.
+ *
+ * @return
+ * - Pointer to the newly created pool if memory allocation is successful.
+ * - `NULL` if memory allocation fails or a parameter is not positive.
+ */
+slab_pool createSlabPool(size_t objectSize, int objectsPerSlab);
+/**
+ * @brief Retrieves the allocator serving blocks from a pool, to be passed to the containers.
+ *
+ * @param pool Pointer to the pool.
+ *
+ * @return
+ * - Pointer to the allocator of the pool, valid as long as the pool.
+ * - `NULL` if the pool is `NULL`.
+ */
+const allocator *getSlabAllocator(slab_pool pool);
+/**
+ * @brief Retrieves the number of blocks of a pool currently handed out.
+ *
+ * @param pool Pointer to the pool.
+ *
+ * @return
+ * - The number of blocks allocated from the pool and not released.
+ * - `0` if the pool is `NULL`.
+ */
+int getSlabPoolUsage(slab_pool pool);
+/**
+ * @brief Frees a pool with all of its slabs in one step.
+ *
+ * Blocks still handed out become invalid. Blocks passed on to `malloc` are not tracked and must
+ * have been released before.
+ *
+ * @param pool Pointer to the pool. The function performs no operation if it is `NULL`.
+ *
+ * @return Void.
+ */
+void destroySlabPool(slab_pool pool);
+
+#endif
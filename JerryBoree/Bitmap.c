@@ -0,0 +1,446 @@
+#include "Bitmap.h"
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/** The largest number of values a container stores as an array, as large as the words of a bitmap container. */
+#define ARRAY_MAX 4096
+/** The number of 64 bit words covering the 65536 low values of a bitmap container. */
+#define WORDS 1024
+
+typedef enum { opAnd, opOr, opAndNot } set_operation;
+
+typedef struct {
+    /**
+ * @brief A container: the values of a bitmap sharing their 16 high bits (`key`).
+ *
+ * The low bits are kept either in `values`, sorted, with room for `capacity` of them, or as
+ * the bits of `words` (then `values` is `NULL`). A container of a bitmap is never empty.
+ */
+    uint16_t key;
+    int cardinality;
+    int capacity;
+    uint16_t *values;
+    uint64_t *words;
+} container_rec;
+
+struct bitmap_rec {
+    /**
+ * @brief Structure representing a bitmap.
+ *
+ * - `containers`: The containers, sorted by key.
+ * - `size` / `capacity`: The number of containers in use and allocated.
+ */
+    container_rec *containers;
+    int size;
+    int capacity;
+};
+
+static int find_container(bitmap set, uint16_t key, int *insertAt) {
+    /**
+ * @brief Searches the containers for a key.
+ *
+ * @param insertAt Output parameter receiving the position a container with the key would take (may be `NULL`).
+ * @return The position of the container, or -1 if there is none.
+ */
+    int low = 0, high = set->size;
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (set->containers[mid].key < key) low = mid + 1;
+        else high = mid;
+    }
+    if (insertAt != NULL) *insertAt = low;
+    if (low < set->size && set->containers[low].key == key) return low;
+    return -1;
+}
+
+static int find_value(container_rec *c, uint16_t low, bool *found) {
+    /**
+ * @brief Searches the array of a container for a value, returning its slot or the slot it would take.
+ */
+    int first = 0, last = c->cardinality;
+    while (first < last) {
+        int mid = (first + last) / 2;
+        if (c->values[mid] < low) first = mid + 1;
+        else last = mid;
+    }
+    *found = first < c->cardinality && c->values[first] == low;
+    return first;
+}
+
+static int count_words(const uint64_t *words) {
+    int cardinality = 0;
+    for (int i = 0; i < WORDS; i++) cardinality += __builtin_popcountll(words[i]);
+    return cardinality;
+}
+
+static bool array_to_words(container_rec *c) {
+    /**
+ * @brief Turns an array container into a bitmap container.
+ */
+    uint64_t *words = (uint64_t *) calloc(WORDS, sizeof(uint64_t));
+    if (words == NULL) return false;
+    for (int i = 0; i < c->cardinality; i++) words[c->values[i] >> 6] |= 1ULL << (c->values[i] & 63);
+    free(c->values);
+    c->values = NULL;
+    c->capacity = 0;
+    c->words = words;
+    return true;
+}
+
+static bool words_to_array(container_rec *c) {
+    /**
+ * @brief Turns a bitmap container into an array container.
+ */
+    uint16_t *values = (uint16_t *) malloc((c->cardinality > 0 ? c->cardinality : 1) * sizeof(uint16_t));
+    if (values == NULL) return false;
+    int n = 0;
+    for (int i = 0; i < WORDS; i++) {
+        for (uint64_t word = c->words[i]; word != 0; word &= word - 1) {
+            values[n++] = (uint16_t) (i * 64 + __builtin_ctzll(word));
+        }
+    }
+    free(c->words);
+    c->words = NULL;
+    c->values = values;
+    c->capacity = c->cardinality;
+    return true;
+}
+
+static void free_container(container_rec *c) {
+    free(c->values);
+    free(c->words);
+}
+
+static bool copy_container(container_rec *source, container_rec *c) {
+    *c = *source;
+    if (source->words != NULL) {
+        c->words = (uint64_t *) malloc(WORDS * sizeof(uint64_t));
+        if (c->words == NULL) return false;
+        memcpy(c->words, source->words, WORDS * sizeof(uint64_t));
+    } else {
+        c->capacity = source->cardinality;
+        c->values = (uint16_t *) malloc(source->cardinality * sizeof(uint16_t));
+        if (c->values == NULL) return false;
+        memcpy(c->values, source->values, source->cardinality * sizeof(uint16_t));
+    }
+    return true;
+}
+
+static int combine_words(uint64_t *out, const uint64_t *a, const uint64_t *b, set_operation op) {
+    /**
+ * @brief Combines the words of two bitmap containers and counts the values of the result.
+ *
+ * With SSE2 two words are combined by each instruction, otherwise one.
+ */
+    int i = 0;
+#ifdef __SSE2__
+    for (; i + 2 <= WORDS; i += 2) {
+        __m128i x = _mm_loadu_si128((const __m128i *) (a + i));
+        __m128i y = _mm_loadu_si128((const __m128i *) (b + i));
+        __m128i r = op == opAnd ? _mm_and_si128(x, y) : op == opOr ? _mm_or_si128(x, y) : _mm_andnot_si128(y, x);
+        _mm_storeu_si128((__m128i *) (out + i), r);
+    }
+#endif
+    for (; i < WORDS; i++) {
+        out[i] = op == opAnd ? a[i] & b[i] : op == opOr ? a[i] | b[i] : a[i] & ~b[i];
+    }
+    return count_words(out);
+}
+
+static bool combine_containers(container_rec *a, container_rec *b, set_operation op, container_rec *out) {
+    /**
+ * @brief Computes `a op b` for two containers with the same key into `out`.
+ *
+ * The result is an array container if it has at most `ARRAY_MAX` values, a bitmap container
+ * otherwise. It may be empty.
+ *
+ * @return `false` if memory allocation fails (`out` then holds nothing to free).
+ */
+    out->key = a->key;
+    out->values = NULL;
+    out->words = NULL;
+    out->capacity = 0;
+    if (a->words != NULL && b->words != NULL) {
+        out->words = (uint64_t *) malloc(WORDS * sizeof(uint64_t));
+        if (out->words == NULL) return false;
+        out->cardinality = combine_words(out->words, a->words, b->words, op);
+    } else if (op == opOr && (a->words != NULL || b->words != NULL || a->cardinality + b->cardinality > ARRAY_MAX)) {
+        //at least one side is an array: start from the words of the other side, or from the first array
+        container_rec *dense = a->words != NULL ? a : b;
+        container_rec *sparse = dense == a ? b : a;
+        out->words = (uint64_t *) calloc(WORDS, sizeof(uint64_t));
+        if (out->words == NULL) return false;
+        if (dense->words != NULL) memcpy(out->words, dense->words, WORDS * sizeof(uint64_t));
+        else for (int i = 0; i < dense->cardinality; i++) out->words[dense->values[i] >> 6] |= 1ULL << (dense->values[i] & 63);
+        for (int i = 0; i < sparse->cardinality; i++) out->words[sparse->values[i] >> 6] |= 1ULL << (sparse->values[i] & 63);
+        out->cardinality = count_words(out->words);
+    } else if (a->words != NULL) {
+        //a bitmap combined with an array
+        if (op == opAnd) {
+            out->values = (uint16_t *) malloc(b->cardinality * sizeof(uint16_t));
+            if (out->values == NULL) return false;
+            int n = 0;
+            for (int i = 0; i < b->cardinality; i++) {
+                if (a->words[b->values[i] >> 6] & (1ULL << (b->values[i] & 63))) out->values[n++] = b->values[i];
+            }
+            out->cardinality = n;
+            out->capacity = b->cardinality;
+            return true;
+        }
+        out->words = (uint64_t *) malloc(WORDS * sizeof(uint64_t));
+        if (out->words == NULL) return false;
+        memcpy(out->words, a->words, WORDS * sizeof(uint64_t));
+        for (int i = 0; i < b->cardinality; i++) {
+            if (op == opOr) out->words[b->values[i] >> 6] |= 1ULL << (b->values[i] & 63);
+            else out->words[b->values[i] >> 6] &= ~(1ULL << (b->values[i] & 63));
+        }
+        out->cardinality = count_words(out->words);
+    } else {
+        //an array intersected with or taken from a bitmap, or combined with an array: the result is an array
+        int bound = op == opOr ? a->cardinality + b->cardinality : a->cardinality;
+        out->values = (uint16_t *) malloc(bound * sizeof(uint16_t));
+        if (out->values == NULL) return false;
+        out->capacity = bound;
+        int n = 0;
+        if (b->words != NULL) {
+            for (int i = 0; i < a->cardinality; i++) {
+                bool inB = (b->words[a->values[i] >> 6] & (1ULL << (a->values[i] & 63))) != 0;
+                if (inB == (op == opAnd)) out->values[n++] = a->values[i];
+            }
+        } else {
+            int i = 0, j = 0;
+            while (i < a->cardinality && j < b->cardinality) {
+                if (a->values[i] < b->values[j]) {
+                    if (op != opAnd) out->values[n++] = a->values[i];
+                    i++;
+                } else if (a->values[i] > b->values[j]) {
+                    if (op == opOr) out->values[n++] = b->values[j];
+                    j++;
+                } else {
+                    if (op != opAndNot) out->values[n++] = a->values[i];
+                    i++;
+                    j++;
+                }
+            }
+            if (op != opAnd) while (i < a->cardinality) out->values[n++] = a->values[i++];
+            if (op == opOr) while (j < b->cardinality) out->values[n++] = b->values[j++];
+        }
+        out->cardinality = n;
+        return true;
+    }
+    //a sparse result of word operations is stored as an array; if that fails the words still hold it
+    if (out->cardinality <= ARRAY_MAX) words_to_array(out);
+    return true;
+}
+
+static status combine_bitmaps(bitmap set, bitmap other, set_operation op) {
+    /**
+ * @brief Replaces the containers of `set` by those of `set op other`, walking both key lists in order.
+ */
+    if (set == NULL || other == NULL) return failure;
+    int bound = op == opOr ? set->size + other->size : set->size;
+    container_rec *result = (container_rec *) malloc((bound > 0 ? bound : 1) * sizeof(container_rec));
+    if (result == NULL) return failure;
+    int n = 0, i = 0, j = 0;
+    bool ok = true;
+    while (ok && (i < set->size || j < other->size)) {
+        container_rec *a = i < set->size ? &set->containers[i] : NULL;
+        container_rec *b = j < other->size ? &other->containers[j] : NULL;
+        if (b == NULL || (a != NULL && a->key < b->key)) {
+            if (op != opAnd) ok = copy_container(a, &result[n++]);
+            i++;
+        } else if (a == NULL || b->key < a->key) {
+            if (op == opOr) ok = copy_container(b, &result[n++]);
+            else if (a == NULL) break;
+            j++;
+        } else {
+            ok = combine_containers(a, b, op, &result[n]);
+            if (ok && result[n].cardinality == 0) free_container(&result[n]);
+            else n++;
+            i++;
+            j++;
+        }
+    }
+    if (!ok) {
+        //a container that failed to be built holds no memory, so all of them can be freed alike
+        for (int k = 0; k < n; k++) free_container(&result[k]);
+        free(result);
+        return failure;
+    }
+    for (int k = 0; k < set->size; k++) free_container(&set->containers[k]);
+    free(set->containers);
+    set->containers = result;
+    set->size = n;
+    set->capacity = bound > 0 ? bound : 1;
+    return success;
+}
+
+bitmap createBitmap(void) {
+    bitmap newSet = (bitmap) malloc(sizeof(struct bitmap_rec));
+    if (newSet == NULL)
+        return NULL;
+    newSet->containers = NULL;
+    newSet->size = 0;
+    newSet->capacity = 0;
+    return newSet;
+}
+
+bitmap copyBitmap(bitmap set) {
+    if (set == NULL) return NULL;
+    bitmap newSet = createBitmap();
+    if (newSet == NULL) return NULL;
+    if (combine_bitmaps(newSet, set, opOr) == failure) {
+        destroyBitmap(newSet);
+        return NULL;
+    }
+    return newSet;
+}
+
+status addToBitmap(bitmap set, uint32_t value) {
+    if (set == NULL) return failure;
+    uint16_t key = (uint16_t) (value >> 16), low = (uint16_t) value;
+    int at;
+    int index = find_container(set, key, &at);
+    if (index < 0) {
+        if (set->size == set->capacity) {
+            int capacity = set->capacity > 0 ? set->capacity * 2 : 4;
+            container_rec *grown = (container_rec *) realloc(set->containers, capacity * sizeof(container_rec));
+            if (grown == NULL) return failure;
+            set->containers = grown;
+            set->capacity = capacity;
+        }
+        uint16_t *values = (uint16_t *) malloc(4 * sizeof(uint16_t));
+        if (values == NULL) return failure;
+        memmove(&set->containers[at + 1], &set->containers[at], (set->size - at) * sizeof(container_rec));
+        set->containers[at] = (container_rec) { key, 0, 4, values, NULL };
+        set->size++;
+        index = at;
+    }
+    container_rec *c = &set->containers[index];
+    if (c->words == NULL) {
+        bool found;
+        int slot = find_value(c, low, &found);
+        if (found) return failure;
+        if (c->cardinality < ARRAY_MAX) {
+            if (c->cardinality == c->capacity) {
+                int capacity = c->capacity * 2 < ARRAY_MAX ? c->capacity * 2 : ARRAY_MAX;
+                uint16_t *grown = (uint16_t *) realloc(c->values, capacity * sizeof(uint16_t));
+                if (grown == NULL) return failure;
+                c->values = grown;
+                c->capacity = capacity;
+            }
+            memmove(&c->values[slot + 1], &c->values[slot], (c->cardinality - slot) * sizeof(uint16_t));
+            c->values[slot] = low;
+            c->cardinality++;
+            return success;
+        }
+        if (!array_to_words(c)) return failure;
+    }
+    uint64_t bit = 1ULL << (low & 63);
+    if (c->words[low >> 6] & bit) return failure;
+    c->words[low >> 6] |= bit;
+    c->cardinality++;
+    return success;
+}
+
+status removeFromBitmap(bitmap set, uint32_t value) {
+    if (set == NULL) return failure;
+    uint16_t low = (uint16_t) value;
+    int index = find_container(set, (uint16_t) (value >> 16), NULL);
+    if (index < 0) return failure;
+    container_rec *c = &set->containers[index];
+    if (c->words != NULL) {
+        uint64_t bit = 1ULL << (low & 63);
+        if ((c->words[low >> 6] & bit) == 0) return failure;
+        c->words[low >> 6] &= ~bit;
+        c->cardinality--;
+        //going back to an array well below the limit keeps alternating additions and removals cheap
+        if (c->cardinality <= ARRAY_MAX / 2) words_to_array(c);
+    } else {
+        bool found;
+        int slot = find_value(c, low, &found);
+        if (!found) return failure;
+        memmove(&c->values[slot], &c->values[slot + 1], (c->cardinality - slot - 1) * sizeof(uint16_t));
+        c->cardinality--;
+    }
+    if (c->cardinality == 0) {
+        free_container(c);
+        memmove(&set->containers[index], &set->containers[index + 1], (set->size - index - 1) * sizeof(container_rec));
+        set->size--;
+    }
+    return success;
+}
+
+bool isInBitmap(bitmap set, uint32_t value) {
+    if (set == NULL) return false;
+    uint16_t low = (uint16_t) value;
+    int index = find_container(set, (uint16_t) (value >> 16), NULL);
+    if (index < 0) return false;
+    container_rec *c = &set->containers[index];
+    if (c->words != NULL) return (c->words[low >> 6] & (1ULL << (low & 63))) != 0;
+    bool found;
+    find_value(c, low, &found);
+    return found;
+}
+
+int getCardinalityBitmap(bitmap set) {
+    if (set == NULL) return 0;
+    int cardinality = 0;
+    for (int i = 0; i < set->size; i++) cardinality += set->containers[i].cardinality;
+    return cardinality;
+}
+
+status andBitmap(bitmap set, bitmap other) {
+    return combine_bitmaps(set, other, opAnd);
+}
+
+status orBitmap(bitmap set, bitmap other) {
+    return combine_bitmaps(set, other, opOr);
+}
+
+status andNotBitmap(bitmap set, bitmap other) {
+    return combine_bitmaps(set, other, opAndNot);
+}
+
+bitmap_iterator bitmapIterator(bitmap set) {
+    bitmap_iterator it = { set, 0, 0, 0 };
+    if (set != NULL && set->size > 0 && set->containers[0].words != NULL) it.word = set->containers[0].words[0];
+    return it;
+}
+
+bool bitmapIteratorNext(bitmap_iterator *it, uint32_t *value) {
+    if (it == NULL || it->set == NULL) return false;
+    while (it->container < it->set->size) {
+        container_rec *c = &it->set->containers[it->container];
+        if (c->words == NULL) {
+            if (it->position < c->cardinality) {
+                *value = ((uint32_t) c->key << 16) | c->values[it->position++];
+                return true;
+            }
+        } else {
+            while (it->word == 0 && ++it->position < WORDS) it->word = c->words[it->position];
+            if (it->word != 0) {
+                *value = ((uint32_t) c->key << 16) | (uint32_t) (it->position * 64 + __builtin_ctzll(it->word));
+                it->word &= it->word - 1;
+                return true;
+            }
+        }
+        it->container++;
+        it->position = 0;
+        it->word = 0;
+        if (it->container < it->set->size && it->set->containers[it->container].words != NULL) {
+            it->word = it->set->containers[it->container].words[0];
+        }
+    }
+    return false;
+}
+
+void destroyBitmap(bitmap set) {
+    if (set == NULL) return;
+    for (int i = 0; i < set->size; i++) free_container(&set->containers[i]);
+    free(set->containers);
+    free(set);
+}
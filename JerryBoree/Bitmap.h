@@ -0,0 +1,161 @@
+#ifndef BITMAP_H
+#define BITMAP_H
+#include "Defs.h"
+
+typedef struct bitmap_rec* bitmap;
+
+/**
+ * @brief A position in a bitmap, kept by the caller while its values are read in increasing order.
+ *
+ * Members (not to be accessed directly):
+ *   - set: The bitmap being read.
+ *   - container: The container holding the next value.
+ *   - position: The next slot of an array container, or the next word of a bitmap container.
+ *   - word: The bits of the current word not returned yet.
+ */
+typedef struct {
+    bitmap set;
+    int container;
+    int position;
+    uint64_t word;
+} bitmap_iterator;
+
+/**
+ * @brief Creates an empty compressed bitmap, a set of 32 bit unsigned integers.
+ *
+ * The bitmap follows the Roaring layout: values are grouped by their 16 high bits into
+ * containers, and each container stores the 16 low bits either as a sorted array (up to 4096
+ * values) or as 1024 words of 64 bits, whichever is smaller. Sparse and dense sets therefore
+ * both stay compact, and set operations between dense containers run a word (or, with SSE2,
+ * two words) at a time.
+ *
+ * @return
+ * - Pointer to the newly created bitmap if memory allocation is successful.
+ * - `NULL` if memory allocation fails.
+ */
+bitmap createBitmap(void);
+/**
+ * @brief Creates a copy of a bitmap holding the same values.
+ *
+ * @param set Pointer to the bitmap to copy.
+ *
+ * @return
+ * - Pointer to the new bitmap if memory allocation is successful.
+ * - `NULL` if the bitmap is `NULL` or memory allocation fails.
+ */
+bitmap copyBitmap(bitmap set);
+/**
+ * @brief Adds a value to the bitmap.
+ *
+ * @param set Pointer to the bitmap.
+ * @param value The value to add.
+ *
+ * @return
+ * - `success` if the value is added.
+ * - `failure` if the bitmap is `NULL`, already holds the value, or memory allocation fails.
+ */
+status addToBitmap(bitmap set, uint32_t value);
+/**
+ * @brief Removes a value from the bitmap.
+ *
+ * @param set Pointer to the bitmap.
+ * @param value The value to remove.
+ *
+ * @return
+ * - `success` if the value is removed.
+ * - `failure` if the bitmap is `NULL` or does not hold the value.
+ */
+status removeFromBitmap(bitmap set, uint32_t value);
+/**
+ * @brief Checks whether the bitmap holds a value.
+ *
+ * @param set Pointer to the bitmap.
+ * @param value The value to search for.
+ *
+ * @return
+ * - `true` if the bitmap holds the value.
+ * - `false` if the bitmap is `NULL` or does not hold the value.
+ */
+bool isInBitmap(bitmap set, uint32_t value);
+/**
+ * @brief Retrieves the number of values in the bitmap.
+ *
+ * @param set Pointer to the bitmap.
+ *
+ * @return
+ * - The number of values in the bitmap.
+ * - `0` if the bitmap is `NULL`.
+ */
+int getCardinalityBitmap(bitmap set);
+/**
+ * @brief Keeps in a bitmap only the values that another bitmap holds too (intersection).
+ *
+ * @param set Pointer to the bitmap to update.
+ * @param other Pointer to the other bitmap, which is not changed.
+ *
+ * @return
+ * - `success` if the bitmap is updated.
+ * - `failure` if one of the bitmaps is `NULL` or memory allocation fails (the bitmap is then unchanged).
+ */
+status andBitmap(bitmap set, bitmap other);
+/**
+ * @brief Adds to a bitmap all the values of another bitmap (union).
+ *
+ * @param set Pointer to the bitmap to update.
+ * @param other Pointer to the other bitmap, which is not changed.
+ *
+ * @return
+ * - `success` if the bitmap is updated.
+ * - `failure` if one of the bitmaps is `NULL` or memory allocation fails (the bitmap is then unchanged).
+ */
+status orBitmap(bitmap set, bitmap other);
+/**
+ * @brief Removes from a bitmap all the values of another bitmap (difference).
+ *
+ * @param set Pointer to the bitmap to update.
+ * @param other Pointer to the other bitmap, which is not changed.
+ *
+ * @return
+ * - `success` if the bitmap is updated.
+ * - `failure` if one of the bitmaps is `NULL` or memory allocation fails (the bitmap is then unchanged).
+ */
+status andNotBitmap(bitmap set, bitmap other);
+/**
+ * @brief Creates an iterator over the values of a bitmap, in increasing order.
+ *
+ * The bitmap must not be changed while the iterator is in use.
+ *
+ * @param set Pointer to the bitmap (may be `NULL`, giving no values).
+ *
+ * @return The iterator, to be read with `bitmapIteratorNext`.
+ */
+bitmap_iterator bitmapIterator(bitmap set);
+/**
+ * @brief Advances an iterator to the next value of its bitmap.
+ *
+ * @param it Pointer to the iterator.
+ * @param value Output parameter receiving the value.
+ *
+ * @return
+ * - `true` if a value is returned.
+ * - `false` once all the values were returned.
+ */
+bool bitmapIteratorNext(bitmap_iterator *it, uint32_t *value);
+/**
+ * @brief Frees a bitmap.
+ *
+ * @param set Pointer to the bitmap. The function performs no operation if it is `NULL`.
+ *
+ * @return Void.
+ */
+void destroyBitmap(bitmap set);
+/**
+ * @brief Macro for iterating through the values of a bitmap in increasing order.
+ *
+ * @param v The `uint32_t` variable to hold the current value during the iteration.
+ * @param b The bitmap to iterate over.
+ */
+#define bitmap_forEach(v, b) \
+    for (bitmap_iterator bitmap_it_ = bitmapIterator(b); bitmapIteratorNext(&bitmap_it_, &(v)); )
+
+#endif
@@ -0,0 +1,447 @@
+#include "ConcurrentHashTable.h"
+#include "HashFunctions.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+
+/**
+ * @brief Number of writer locks. A bucket is guarded by the stripe selected by the low bits
+ * of its keys' hashes, which stays the same when the bucket array doubles.
+ */
+#define CONCURRENT_STRIPES 64
+
+/**
+ * @brief Number of retired nodes collected before writers wait for a grace period and free them.
+ */
+#define RETIRE_THRESHOLD 64
+
+/**
+ * @brief The table doubles its number of buckets once it holds more pairs than this many per bucket.
+ */
+#define CONCURRENT_MAX_LOAD_FACTOR 1
+
+/**
+ * @brief A single pair stored in a bucket.
+ *
+ * Readers follow `next` without locks, so a node is fully initialized before it is published
+ * and is never modified afterwards, except for the link that unlinks its successor.
+ * `ownsElements` is cleared when a resize hands the key and value over to a copy of the node;
+ * `retiredNext` links the node into the list of nodes waiting to be freed.
+ */
+typedef struct cnode_rec {
+    Element key;
+    Element value;
+    uint64_t hash;
+    _Atomic(struct cnode_rec *) next;
+    bool ownsElements;
+    struct cnode_rec *retiredNext;
+} *cnode;
+
+/**
+ * @brief A bucket array. Readers load the current array once per operation, so a resize
+ * publishes a complete new array and retires the old one like a removed node.
+ */
+typedef struct ctable_rec {
+    int size;
+    struct ctable_rec *retiredNext;
+    _Atomic(cnode) buckets[];
+} *ctable;
+
+/**
+ * @brief A mutex padded to its own cache line, so that writers of neighbouring stripes do
+ * not slow each other down.
+ */
+typedef union {
+    pthread_mutex_t lock;
+    char pad[64];
+} stripe_lock;
+
+/**
+ * @brief Read side state of the epoch based reclamation.
+ *
+ * Readers register in the counter of the current epoch's parity. A writer that wants to
+ * free retired nodes advances the epoch and waits until the counter of the previous parity
+ * drains; every reader that could have reached the retired nodes has then finished.
+ */
+typedef union {
+    atomic_long count;
+    char pad[64];
+} reader_counter;
+
+struct concurrentHashTable_s {
+    _Atomic(ctable) table;
+    stripe_lock stripes[CONCURRENT_STRIPES];
+    atomic_int count;
+    atomic_ulong epoch;
+    reader_counter readers[2];
+    pthread_mutex_t reclaimLock;
+    cnode retiredNodes;
+    int retiredNum;
+    ctable retiredTables;
+    CopyFunction copyKey;
+    FreeFunction freeKey;
+    PrintFunction printKey;
+    CopyFunction copyValue;
+    FreeFunction freeValue;
+    PrintFunction printValue;
+    EqualFunction equalKey;
+    HashFunction hashKey;
+    uint64_t seed;
+};
+
+static uint64_t concurrent_hash(concurrentHashTable t, Element key) {
+    /**
+ * @brief Computes the hash a key is stored under.
+ *
+ * Buckets and stripes are selected by the low bits of the hash, so the hash is passed
+ * through a 64 bit finalizer to make those bits depend on the whole hash.
+ *
+ * @param t The hash table.
+ * @param key The key to hash.
+ * @return The hash of the key.
+ */
+    uint64_t h = t->hashKey(key, t->seed);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+static ctable create_ctable(int size) {
+    ctable tb = (ctable)malloc(sizeof(struct ctable_rec) + size * sizeof(_Atomic(cnode)));
+    if (tb == NULL) return NULL;
+    tb->size = size;
+    tb->retiredNext = NULL;
+    for (int i = 0; i < size; i++) {
+        atomic_init(&tb->buckets[i], NULL);
+    }
+    return tb;
+}
+
+static pthread_mutex_t *stripe_of(concurrentHashTable t, uint64_t h) {
+    return &t->stripes[h & (CONCURRENT_STRIPES - 1)].lock;
+}
+
+static _Atomic(cnode) *bucket_of(ctable tb, uint64_t h) {
+    return &tb->buckets[h & (uint64_t) (tb->size - 1)];
+}
+
+static unsigned long read_enter(concurrentHashTable t) {
+    /**
+ * @brief Starts a read side critical section.
+ *
+ * The reader registers in the counter of the current epoch. If the epoch moved on while it
+ * registered, a writer may already be waiting on that counter without having seen it, so
+ * the reader moves to the counter of the new epoch instead.
+ *
+ * @param t The hash table.
+ * @return The epoch the reader registered in, to be passed to `read_exit`.
+ */
+    while (true) {
+        unsigned long e = atomic_load(&t->epoch);
+        atomic_fetch_add(&t->readers[e & 1].count, 1);
+        if (atomic_load(&t->epoch) == e) return e;
+        atomic_fetch_sub(&t->readers[e & 1].count, 1);
+    }
+}
+
+static void read_exit(concurrentHashTable t, unsigned long e) {
+    atomic_fetch_sub(&t->readers[e & 1].count, 1);
+}
+
+static void wait_for_readers(concurrentHashTable t) {
+    /**
+ * @brief Waits until every reader that started before the call has finished.
+ *
+ * Must be called with `reclaimLock` held, which keeps grace periods from overlapping.
+ */
+    unsigned long e = atomic_fetch_add(&t->epoch, 1);
+    while (atomic_load(&t->readers[e & 1].count) != 0) {
+        sched_yield();
+    }
+}
+
+static void free_retired(concurrentHashTable t, cnode nodes, ctable tables) {
+    while (nodes != NULL) {
+        cnode next = nodes->retiredNext;
+        if (nodes->ownsElements) {
+            t->freeKey(nodes->key);
+            t->freeValue(nodes->value);
+        }
+        free(nodes);
+        nodes = next;
+    }
+    while (tables != NULL) {
+        ctable next = tables->retiredNext;
+        free(tables);
+        tables = next;
+    }
+}
+
+static void reclaim_locked(concurrentHashTable t) {
+    /**
+ * @brief Frees everything retired so far. Must be called with `reclaimLock` held.
+ */
+    cnode nodes = t->retiredNodes;
+    ctable tables = t->retiredTables;
+    t->retiredNodes = NULL;
+    t->retiredTables = NULL;
+    t->retiredNum = 0;
+    wait_for_readers(t);
+    free_retired(t, nodes, tables);
+}
+
+static void retire(concurrentHashTable t, cnode first, cnode last, int num, ctable tb) {
+    /**
+ * @brief Hands unlinked nodes (and optionally a bucket array) over to be freed later.
+ *
+ * Once enough nodes are collected the calling writer waits for a grace period and frees
+ * them, so the cost of waiting is shared by many removals.
+ *
+ * @param t The hash table.
+ * @param first The first of a chain of nodes linked by `retiredNext` (may be `NULL`).
+ * @param last The last node of the chain.
+ * @param num The number of nodes in the chain.
+ * @param tb A retired bucket array (may be `NULL`).
+ */
+    pthread_mutex_lock(&t->reclaimLock);
+    if (first != NULL) {
+        last->retiredNext = t->retiredNodes;
+        t->retiredNodes = first;
+        t->retiredNum += num;
+    }
+    if (tb != NULL) {
+        tb->retiredNext = t->retiredTables;
+        t->retiredTables = tb;
+    }
+    if (t->retiredNum >= RETIRE_THRESHOLD || tb != NULL) reclaim_locked(t);
+    pthread_mutex_unlock(&t->reclaimLock);
+}
+
+static void grow(concurrentHashTable t) {
+    /**
+ * @brief Doubles the number of buckets.
+ *
+ * All stripes are locked, so no writer runs meanwhile. Readers may still be walking the old
+ * chains, so those are left intact: every node is copied into the new bucket array, which is
+ * then published at once, and the old nodes and array are retired.
+ */
+    for (int i = 0; i < CONCURRENT_STRIPES; i++) {
+        pthread_mutex_lock(&t->stripes[i].lock);
+    }
+    ctable old = atomic_load(&t->table);
+    ctable tb = NULL;
+    if (atomic_load(&t->count) > CONCURRENT_MAX_LOAD_FACTOR * old->size) {
+        tb = create_ctable(old->size * 2);
+    }
+    bool copied = tb != NULL;
+    for (int i = 0; copied && i < old->size; i++) {
+        for (cnode n = atomic_load(&old->buckets[i]); n != NULL; n = atomic_load(&n->next)) {
+            cnode copy = (cnode)malloc(sizeof(struct cnode_rec));
+            if (copy == NULL) {
+                copied = false;
+                break;
+            }
+            copy->key = n->key;
+            copy->value = n->value;
+            copy->hash = n->hash;
+            copy->ownsElements = true;
+            copy->retiredNext = NULL;
+            _Atomic(cnode) *bucket = bucket_of(tb, n->hash);
+            atomic_init(&copy->next, atomic_load_explicit(bucket, memory_order_relaxed));
+            atomic_store_explicit(bucket, copy, memory_order_relaxed);
+        }
+    }
+    cnode first = NULL, last = NULL;
+    int num = 0;
+    if (copied) {
+        atomic_store_explicit(&t->table, tb, memory_order_release);
+        for (int i = 0; i < old->size; i++) {
+            for (cnode n = atomic_load(&old->buckets[i]); n != NULL; n = atomic_load(&n->next)) {
+                n->ownsElements = false;
+                n->retiredNext = first;
+                if (first == NULL) last = n;
+                first = n;
+                num++;
+            }
+        }
+    } else if (tb != NULL) {  //out of memory, keep the old array
+        for (int i = 0; i < tb->size; i++) {
+            cnode n = atomic_load(&tb->buckets[i]);
+            while (n != NULL) {
+                cnode next = atomic_load(&n->next);
+                free(n);
+                n = next;
+            }
+        }
+        free(tb);
+    }
+    for (int i = CONCURRENT_STRIPES - 1; i >= 0; i--) {
+        pthread_mutex_unlock(&t->stripes[i].lock);
+    }
+    if (copied) retire(t, first, last, num, old);
+}
+
+static int next_power_of_two(int n) {
+    int p = CONCURRENT_STRIPES;
+    while (p < n) p *= 2;
+    return p;
+}
+
+
+
+concurrentHashTable createConcurrentHashTable(CopyFunction copyKey, FreeFunction freeKey, PrintFunction printKey,
+    CopyFunction copyValue, FreeFunction freeValue, PrintFunction printValue, EqualFunction equalKey,
+    HashFunction hashKey, int hashNumber) {
+    if (hashNumber <= 0) return NULL;
+    concurrentHashTable t = (concurrentHashTable)malloc(sizeof(struct concurrentHashTable_s));
+    if (t == NULL) return NULL;
+    ctable tb = create_ctable(next_power_of_two(hashNumber));
+    if (tb == NULL) {
+        free(t);
+        return NULL;
+    }
+    atomic_init(&t->table, tb);
+    for (int i = 0; i < CONCURRENT_STRIPES; i++) {
+        pthread_mutex_init(&t->stripes[i].lock, NULL);
+    }
+    atomic_init(&t->count, 0);
+    atomic_init(&t->epoch, 0);
+    atomic_init(&t->readers[0].count, 0);
+    atomic_init(&t->readers[1].count, 0);
+    pthread_mutex_init(&t->reclaimLock, NULL);
+    t->retiredNodes = NULL;
+    t->retiredNum = 0;
+    t->retiredTables = NULL;
+    t->copyKey = copyKey;
+    t->freeKey = freeKey;
+    t->printKey = printKey;
+    t->copyValue = copyValue;
+    t->freeValue = freeValue;
+    t->printValue = printValue;
+    t->equalKey = equalKey;
+    t->hashKey = hashKey;
+    t->seed = DEFAULT_HASH_SEED;
+    return t;
+}
+
+status setConcurrentHashTableSeed(concurrentHashTable t, uint64_t seed) {
+    if (t == NULL || atomic_load(&t->count) > 0) return failure;
+    t->seed = seed;
+    return success;
+}
+
+status destroyConcurrentHashTable(concurrentHashTable t) {
+    if (t == NULL) return failure;
+    free_retired(t, t->retiredNodes, t->retiredTables);
+    ctable tb = atomic_load(&t->table);
+    for (int i = 0; i < tb->size; i++) {
+        cnode n = atomic_load(&tb->buckets[i]);
+        while (n != NULL) {
+            cnode next = atomic_load(&n->next);
+            t->freeKey(n->key);
+            t->freeValue(n->value);
+            free(n);
+            n = next;
+        }
+    }
+    free(tb);
+    for (int i = 0; i < CONCURRENT_STRIPES; i++) {
+        pthread_mutex_destroy(&t->stripes[i].lock);
+    }
+    pthread_mutex_destroy(&t->reclaimLock);
+    free(t);
+    return success;
+}
+
+status addToConcurrentHashTable(concurrentHashTable t, Element key, Element value) {
+    if (t == NULL || key == NULL || value == NULL) return failure;
+    uint64_t h = concurrent_hash(t, key);
+    pthread_mutex_t *lock = stripe_of(t, h);
+    pthread_mutex_lock(lock);
+    //the bucket array can only be replaced while all stripes are locked
+    ctable tb = atomic_load_explicit(&t->table, memory_order_relaxed);
+    _Atomic(cnode) *bucket = bucket_of(tb, h);
+    for (cnode n = atomic_load_explicit(bucket, memory_order_relaxed); n != NULL;
+         n = atomic_load_explicit(&n->next, memory_order_relaxed)) {
+        if (n->hash == h && t->equalKey(n->key, key) == true) {
+            pthread_mutex_unlock(lock);
+            return failure;
+        }
+    }
+    cnode node = (cnode)malloc(sizeof(struct cnode_rec));
+    if (node == NULL) {
+        pthread_mutex_unlock(lock);
+        return failure;
+    }
+    node->key = t->copyKey(key);
+    node->value = t->copyValue(value);
+    node->hash = h;
+    node->ownsElements = true;
+    node->retiredNext = NULL;
+    atomic_init(&node->next, atomic_load_explicit(bucket, memory_order_relaxed));
+    //publish the node only once it is complete
+    atomic_store_explicit(bucket, node, memory_order_release);
+    int size = tb->size;  //tb may be retired as soon as the stripe is unlocked
+    pthread_mutex_unlock(lock);
+    if (atomic_fetch_add(&t->count, 1) + 1 > CONCURRENT_MAX_LOAD_FACTOR * size) grow(t);
+    return success;
+}
+
+Element lookupInConcurrentHashTable(concurrentHashTable t, Element key) {
+    if (t == NULL || key == NULL) return NULL;
+    uint64_t h = concurrent_hash(t, key);
+    Element res = NULL;
+    unsigned long e = read_enter(t);
+    ctable tb = atomic_load_explicit(&t->table, memory_order_acquire);
+    for (cnode n = atomic_load_explicit(bucket_of(tb, h), memory_order_acquire); n != NULL;
+         n = atomic_load_explicit(&n->next, memory_order_acquire)) {
+        if (n->hash == h && t->equalKey(n->key, key) == true) {
+            res = t->copyValue(n->value);
+            break;
+        }
+    }
+    read_exit(t, e);
+    return res;
+}
+
+status removeFromConcurrentHashTable(concurrentHashTable t, Element key) {
+    if (t == NULL || key == NULL) return failure;
+    uint64_t h = concurrent_hash(t, key);
+    pthread_mutex_t *lock = stripe_of(t, h);
+    pthread_mutex_lock(lock);
+    ctable tb = atomic_load_explicit(&t->table, memory_order_relaxed);
+    _Atomic(cnode) *link = bucket_of(tb, h);
+    cnode n = atomic_load_explicit(link, memory_order_relaxed);
+    while (n != NULL && (n->hash != h || t->equalKey(n->key, key) == false)) {
+        link = &n->next;
+        n = atomic_load_explicit(link, memory_order_relaxed);
+    }
+    if (n == NULL) {
+        pthread_mutex_unlock(lock);
+        return failure;
+    }
+    //readers standing on the node can still follow its next pointer
+    atomic_store_explicit(link, atomic_load_explicit(&n->next, memory_order_relaxed), memory_order_release);
+    pthread_mutex_unlock(lock);
+    atomic_fetch_sub(&t->count, 1);
+    retire(t, n, n, 1, NULL);
+    return success;
+}
+
+status displayConcurrentHashElements(concurrentHashTable t) {
+    if (t == NULL) return failure;
+    unsigned long e = read_enter(t);
+    ctable tb = atomic_load_explicit(&t->table, memory_order_acquire);
+    for (int i = 0; i < tb->size; i++) {
+        for (cnode n = atomic_load_explicit(&tb->buckets[i], memory_order_acquire); n != NULL;
+             n = atomic_load_explicit(&n->next, memory_order_acquire)) {
+            t->printKey(n->key);
+            t->printValue(n->value);
+        }
+    }
+    read_exit(t, e);
+    return success;
+}
@@ -0,0 +1,122 @@
+#ifndef CONCURRENT_HASH_TABLE_H
+#define CONCURRENT_HASH_TABLE_H
+#include "Defs.h"
+
+typedef struct concurrentHashTable_s *concurrentHashTable;
+/**
+ * @brief Creates a hash table that can be used from many threads at once.
+ *
+ * Keys are spread over chained buckets whose heads and links are updated atomically.
+ * Writers (`addToConcurrentHashTable`, `removeFromConcurrentHashTable`) lock one of 64 stripes
+ * of buckets, so writers of different stripes run in parallel. Readers
+ * (`lookupInConcurrentHashTable`) take no lock at all and never wait for writers.
+ *
+ * Removed pairs are not freed immediately: a reader may still be looking at them. They are
+ * collected and freed in batches once every reader that could have seen them has finished.
+ * The table doubles its number of buckets when it holds more pairs than buckets, and never
+ * shrinks.
+ *
+ * The utility functions may be called from several threads at once and must be thread safe.
+ *
+ * @param copyKey Function pointer for creating a deep copy of a key.
+ * @param freeKey Function pointer for freeing the memory of a key.
+ * @param printKey Function pointer for printing a key.
+ * @param copyValue Function pointer for creating a deep copy of a value.
+ * @param freeValue Function pointer for freeing the memory of a value.
+ * @param printValue Function pointer for printing a value.
+ * @param equalKey Function pointer for comparing two keys for equality.
+ * @param hashKey Function pointer for computing the seeded 64 bit hash of a key (see HashFunctions.h).
+ * @param hashNumber The initial number of buckets, rounded up to a power of two (at least 64).
+ *
+ * @return
+ * - Pointer to the newly created hash table if memory allocation is successful.
+ * - `NULL` if memory allocation fails at any stage.
+ */
+concurrentHashTable createConcurrentHashTable(CopyFunction copyKey, FreeFunction freeKey, PrintFunction printKey,
+    CopyFunction copyValue, FreeFunction freeValue, PrintFunction printValue, EqualFunction equalKey,
+    HashFunction hashKey, int hashNumber);
+/**
+ * @brief Changes the seed passed to the table's hash function.
+ *
+ * Tables start with `DEFAULT_HASH_SEED`. A random seed makes it impossible to predict which keys
+ * collide. Since every key would move, the seed can only be changed while the table is empty,
+ * and, like `destroyConcurrentHashTable`, not while other threads use the table.
+ *
+ * @param t Pointer to the hash table.
+ * @param seed The new seed.
+ *
+ * @return
+ * - `success` if the seed is updated.
+ * - `failure` if the hash table is `NULL` or not empty.
+ */
+status setConcurrentHashTableSeed(concurrentHashTable t, uint64_t seed);
+/**
+ * @brief Destroys a concurrent hash table and frees all associated memory.
+ *
+ * Unlike the other operations, this function must not run while other threads use the table.
+ *
+ * @param t Pointer to the hash table to be destroyed.
+ *
+ * @return
+ * - `success` if the hash table is successfully destroyed.
+ * - `failure` if the hash table is `NULL`.
+ */
+status destroyConcurrentHashTable(concurrentHashTable t);
+/**
+ * @brief Adds a key-value pair to the concurrent hash table.
+ *
+ * The key and the value are copied. If a pair with the same key already exists the insertion
+ * fails, also when both threads insert the same key at the same time.
+ *
+ * @param t Pointer to the hash table.
+ * @param key The key of the key-value pair to be added.
+ * @param value The value of the key-value pair to be added.
+ *
+ * @return
+ * - `success` if the key-value pair is successfully added.
+ * - `failure` if the hash table, key, or value is `NULL`, memory allocation fails,
+ *   or a pair with the same key already exists.
+ */
+status addToConcurrentHashTable(concurrentHashTable t, Element key, Element value);
+/**
+ * @brief Retrieves a copy of the value associated with a given key without taking any lock.
+ *
+ * The value is copied while the pair is still protected from being freed, so the caller
+ * owns the returned copy even if another thread removes the key right afterwards.
+ *
+ * @param t Pointer to the hash table.
+ * @param key The key to search for.
+ *
+ * @return
+ * - Copy of the value associated with the key if the key exists in the hash table.
+ * - `NULL` if the hash table or key is `NULL`, or if the key does not exist in the hash table.
+ */
+Element lookupInConcurrentHashTable(concurrentHashTable t, Element key);
+/**
+ * @brief Removes a key-value pair from the concurrent hash table.
+ *
+ * The pair disappears from the table at once, but its key and value are only freed once
+ * no reader can still be using them.
+ *
+ * @param t Pointer to the hash table.
+ * @param key The key of the key-value pair to be removed.
+ *
+ * @return
+ * - `success` if the key-value pair is successfully removed.
+ * - `failure` if the hash table, key is `NULL`, or the key does not exist in the hash table.
+ */
+status removeFromConcurrentHashTable(concurrentHashTable t, Element key);
+/**
+ * @brief Displays all key-value pairs in the concurrent hash table.
+ *
+ * Pairs added or removed by other threads during the call may or may not be displayed.
+ *
+ * @param t Pointer to the hash table.
+ *
+ * @return
+ * - `success` if all elements are successfully displayed.
+ * - `failure` if the hash table is `NULL`.
+ */
+status displayConcurrentHashElements(concurrentHashTable t);
+
+#endif /* CONCURRENT_HASH_TABLE_H */
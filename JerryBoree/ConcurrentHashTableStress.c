@@ -0,0 +1,183 @@
+#include "ConcurrentHashTable.h"
+#include "HashFunctions.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+
+/**
+ * @brief Stress test of the concurrent hash table.
+ *
+ * Writer threads add and remove keys while reader threads look them up, all at once, and the
+ * final contents of the table are checked against what the writers did:
+ * - Every writer owns a range of keys no other thread writes, and remembers which of them it
+ *   left in the table; each of its insertions and removals must succeed exactly when that says.
+ * - All writers also race on a range of shared keys, counting the insertions and removals that
+ *   succeeded; a shared key ends up in the table exactly when one more insertion than removals
+ *   succeeded, and never more than one.
+ * - Every value is derived from its key, so a reader that finds a key with another value saw a
+ *   pair that was freed or not fully published.
+ *
+ * Usage: ConcurrentHashTableStress [writers] [readers] [operations per writer]
+ */
+
+#define OWN_KEYS 20000
+#define SHARED_KEYS 512
+#define MAX_WRITERS 64
+
+static concurrentHashTable table;
+static int writers = 4;
+static int readers = 2;
+static int operations = 100000;
+static atomic_int writers_done;
+static atomic_long errors;
+static atomic_int shared_net[SHARED_KEYS];
+static bool *present[MAX_WRITERS];
+
+static Element copy_string(Element s) {
+    char *copy = (char *) malloc(strlen((char *) s) + 1);
+    if (copy != NULL) strcpy(copy, (char *) s);
+    return copy;
+}
+
+static status free_string(Element s) {
+    free(s);
+    return success;
+}
+
+static status print_string(Element s) {
+    printf("%s", (char *) s);
+    return success;
+}
+
+static bool equal_strings(Element a, Element b) {
+    return strcmp((char *) a, (char *) b) == 0;
+}
+
+static void key_name(char *buffer, int owner, int key) {
+    //owner -1 is the shared range
+    if (owner < 0) sprintf(buffer, "shared-%d", key);
+    else sprintf(buffer, "own-%d-%d", owner, key);
+}
+
+static void value_name(char *buffer, const char *key) {
+    sprintf(buffer, "value-of-%s", key);
+}
+
+static uint64_t next_random(uint64_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static void *writer(void *arg) {
+    int id = (int) (intptr_t) arg;
+    uint64_t state = 0x9E3779B97F4A7C15ULL * (id + 1);
+    char key[64], value[96];
+    for (int i = 0; i < operations; i++) {
+        uint64_t r = next_random(&state);
+        bool shared = r % 4 == 0;
+        int k = (int) ((r >> 8) % (shared ? SHARED_KEYS : OWN_KEYS));
+        key_name(key, shared ? -1 : id, k);
+        if ((r >> 40) % 2 == 0) {
+            value_name(value, key);
+            status added = addToConcurrentHashTable(table, key, value);
+            if (shared) {
+                if (added == success) atomic_fetch_add(&shared_net[k], 1);
+            } else if ((added == success) == present[id][k]) {
+                //an insertion succeeds exactly when the key is not in the table
+                atomic_fetch_add(&errors, 1);
+            } else {
+                present[id][k] = true;
+            }
+        } else {
+            status removed = removeFromConcurrentHashTable(table, key);
+            if (shared) {
+                if (removed == success) atomic_fetch_sub(&shared_net[k], 1);
+            } else if ((removed == success) != present[id][k]) {
+                atomic_fetch_add(&errors, 1);
+            } else {
+                present[id][k] = false;
+            }
+        }
+    }
+    atomic_fetch_add(&writers_done, 1);
+    return NULL;
+}
+
+static void *reader(void *arg) {
+    uint64_t state = 0xD1B54A32D192ED03ULL * ((intptr_t) arg + 1);
+    char key[64], value[96];
+    long lookups = 0;
+    while (atomic_load(&writers_done) < writers || lookups < 1000) {
+        uint64_t r = next_random(&state);
+        bool shared = r % 2 == 0;
+        int k = (int) ((r >> 8) % (shared ? SHARED_KEYS : OWN_KEYS));
+        key_name(key, shared ? -1 : (int) ((r >> 40) % writers), k);
+        char *found = (char *) lookupInConcurrentHashTable(table, key);
+        if (found != NULL) {
+            value_name(value, key);
+            if (strcmp(found, value) != 0) atomic_fetch_add(&errors, 1);
+            free(found);
+        }
+        lookups++;
+    }
+    return NULL;
+}
+
+static long check_final_contents(void) {
+    char key[64], value[96];
+    long wrong = 0;
+    for (int w = 0; w < writers; w++) {
+        for (int k = 0; k < OWN_KEYS; k++) {
+            key_name(key, w, k);
+            char *found = (char *) lookupInConcurrentHashTable(table, key);
+            value_name(value, key);
+            if ((found != NULL) != present[w][k] || (found != NULL && strcmp(found, value) != 0)) wrong++;
+            free(found);
+        }
+    }
+    for (int k = 0; k < SHARED_KEYS; k++) {
+        key_name(key, -1, k);
+        char *found = (char *) lookupInConcurrentHashTable(table, key);
+        int net = atomic_load(&shared_net[k]);
+        if (net != 0 && net != 1) wrong++;
+        if ((found != NULL) != (net == 1)) wrong++;
+        free(found);
+    }
+    return wrong;
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1) writers = atoi(argv[1]);
+    if (argc > 2) readers = atoi(argv[2]);
+    if (argc > 3) operations = atoi(argv[3]);
+    if (writers < 1 || writers > MAX_WRITERS || readers < 0 || operations < 0) {
+        printf("usage: %s [writers (1-%d)] [readers] [operations per writer]\n", argv[0], MAX_WRITERS);
+        return 1;
+    }
+    table = createConcurrentHashTable(copy_string, free_string, print_string, copy_string, free_string,
+        print_string, equal_strings, wyhashString, 64);
+    if (table == NULL || setConcurrentHashTableSeed(table, (uint64_t) time(NULL) * 0x9E3779B97F4A7C15ULL) == failure) {
+        printf("could not create the table\n");
+        return 1;
+    }
+    for (int w = 0; w < writers; w++) {
+        present[w] = (bool *) calloc(OWN_KEYS, sizeof(bool));
+        if (present[w] == NULL) {
+            printf("out of memory\n");
+            return 1;
+        }
+    }
+    pthread_t threads[MAX_WRITERS * 2];
+    int readers_started = readers < MAX_WRITERS ? readers : MAX_WRITERS;
+    for (int w = 0; w < writers; w++) pthread_create(&threads[w], NULL, writer, (void *) (intptr_t) w);
+    for (int r = 0; r < readers_started; r++) pthread_create(&threads[writers + r], NULL, reader, (void *) (intptr_t) r);
+    for (int i = 0; i < writers + readers_started; i++) pthread_join(threads[i], NULL);
+    long wrong = check_final_contents();
+    printf("%d writers x %d operations, %d readers: %ld errors seen, %ld wrong keys at the end\n",
+        writers, operations, readers_started, atomic_load(&errors), wrong);
+    destroyConcurrentHashTable(table);
+    for (int w = 0; w < writers; w++) free(present[w]);
+    return atomic_load(&errors) == 0 && wrong == 0 ? 0 : 1;
+}
@@ -3,6 +3,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdint.h>
 
 typedef enum e_bool { false, true } bool;
 typedef enum e_status { success, failure } status;
@@ -12,7 +13,8 @@ typedef void * Element;
 typedef Element(*CopyFunction) (Element);
 typedef status(*FreeFunction) (Element);
 typedef status(*PrintFunction) (Element);
-typedef int(*TransformIntoNumberFunction) (Element);
+typedef uint64_t(*HashFunction) (Element, uint64_t);
 typedef bool(*EqualFunction) (Element, Element);
+typedef int(*CompareFunction) (Element, Element);
 
 #endif /* DEFS_H_ */
@@ -0,0 +1,118 @@
+#include <limits.h>
+#include "HappinessKernel.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define AVX2_DISPATCH
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/** The lowest and highest happiness levels. */
+#define SADDEST 0
+#define HAPPIEST 100
+/** The largest amount an activity adds or subtracts, so that no bound of a level overflows. */
+#define AMOUNT_LIMIT (INT_MAX - HAPPIEST)
+
+typedef void (*activity_kernel)(int *happiness, int count, int min, int subtraction, int add);
+
+static void activity_scalar(int *happiness, int count, int min, int subtraction, int add) {
+    /**
+ * @brief Runs an activity one level at a time.
+ *
+ * Each level is clamped to the levels that land in [0, 100] once the change is made, and then
+ * changed, which gives the clamped result without ever leaving the range of an int.
+ */
+    for (int i = 0; i < count; i++) {
+        int change = happiness[i] < min ? -subtraction : add;
+        int level = happiness[i];
+        if (level < SADDEST - change) level = SADDEST - change;
+        if (level > HAPPIEST - change) level = HAPPIEST - change;
+        happiness[i] = level + change;
+    }
+}
+
+#ifdef __SSE2__
+static void activity_sse2(int *happiness, int count, int min, int subtraction, int add) {
+    /**
+ * @brief Runs an activity four levels at a time.
+ *
+ * SSE2 has neither a blend nor a minimum or maximum of 32 bit integers, so the comparison masks
+ * select between the two sides with and / and-not / or.
+ */
+    __m128i threshold = _mm_set1_epi32(min);
+    __m128i loss = _mm_set1_epi32(-subtraction);
+    __m128i gain = _mm_set1_epi32(add);
+    __m128i happiest = _mm_set1_epi32(HAPPIEST);
+    __m128i saddest = _mm_set1_epi32(SADDEST);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i level = _mm_loadu_si128((const __m128i *) (happiness + i));
+        __m128i below = _mm_cmpgt_epi32(threshold, level);
+        __m128i change = _mm_or_si128(_mm_and_si128(below, loss), _mm_andnot_si128(below, gain));
+        __m128i lowest = _mm_sub_epi32(saddest, change);
+        __m128i highest = _mm_sub_epi32(happiest, change);
+        __m128i under = _mm_cmpgt_epi32(lowest, level);
+        level = _mm_or_si128(_mm_and_si128(under, lowest), _mm_andnot_si128(under, level));
+        __m128i over = _mm_cmpgt_epi32(level, highest);
+        level = _mm_or_si128(_mm_and_si128(over, highest), _mm_andnot_si128(over, level));
+        level = _mm_add_epi32(level, change);
+        _mm_storeu_si128((__m128i *) (happiness + i), level);
+    }
+    activity_scalar(happiness + i, count - i, min, subtraction, add);
+}
+#endif
+
+#ifdef AVX2_DISPATCH
+__attribute__((target("avx2")))
+static void activity_avx2(int *happiness, int count, int min, int subtraction, int add) {
+    /**
+ * @brief Runs an activity eight levels at a time.
+ *
+ * Compiled for AVX2 whatever the flags of the build, and only called once the processor is
+ * known to support it.
+ */
+    __m256i threshold = _mm256_set1_epi32(min);
+    __m256i loss = _mm256_set1_epi32(-subtraction);
+    __m256i gain = _mm256_set1_epi32(add);
+    __m256i happiest = _mm256_set1_epi32(HAPPIEST);
+    __m256i saddest = _mm256_set1_epi32(SADDEST);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i level = _mm256_loadu_si256((const __m256i *) (happiness + i));
+        __m256i below = _mm256_cmpgt_epi32(threshold, level);
+        __m256i change = _mm256_blendv_epi8(gain, loss, below);
+        level = _mm256_max_epi32(level, _mm256_sub_epi32(saddest, change));
+        level = _mm256_min_epi32(level, _mm256_sub_epi32(happiest, change));
+        level = _mm256_add_epi32(level, change);
+        _mm256_storeu_si256((__m256i *) (happiness + i), level);
+    }
+    activity_scalar(happiness + i, count - i, min, subtraction, add);
+}
+#endif
+
+/** The path running the activities, chosen on the first activity. */
+static activity_kernel kernel = NULL;
+
+static void choose_kernel(void) {
+    kernel = activity_scalar;
+#ifdef __SSE2__
+    kernel = activity_sse2;
+#endif
+#ifdef AVX2_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        kernel = activity_avx2;
+    }
+#endif
+}
+
+void runActivity(int *happiness, int count, int min, int subtraction, int add) {
+    if (happiness == NULL || count <= 0) return;
+    if (kernel == NULL) choose_kernel();
+    if (subtraction > AMOUNT_LIMIT) subtraction = AMOUNT_LIMIT;
+    if (subtraction < -AMOUNT_LIMIT) subtraction = -AMOUNT_LIMIT;
+    if (add > AMOUNT_LIMIT) add = AMOUNT_LIMIT;
+    if (add < -AMOUNT_LIMIT) add = -AMOUNT_LIMIT;
+    kernel(happiness, count, min, subtraction, add);
+}
@@ -0,0 +1,25 @@
+#ifndef HAPPINESS_KERNEL_H
+#define HAPPINESS_KERNEL_H
+#include "Defs.h"
+
+/**
+ * @brief Runs a daycare activity over a contiguous array of happiness levels.
+ *
+ * Every level below `min` loses `subtraction`, every other level gains `add`, and the result is
+ * clamped to [0, 100]. The levels are processed eight at a time with AVX2 or four at a time with
+ * SSE2, without branches, and one at a time otherwise. The path is chosen once, the first time an
+ * activity runs, from the instruction sets the processor supports; all paths give the same levels.
+ * The amounts are clamped to [-(INT_MAX - 100), INT_MAX - 100], and no level overflows on the way,
+ * whatever the levels in the array.
+ *
+ * @param happiness The array of happiness levels, updated in place.
+ * @param count The number of levels in the array.
+ * @param min The happiness threshold.
+ * @param subtraction The amount subtracted from the levels below the threshold.
+ * @param add The amount added to the other levels.
+ *
+ * @return Void.
+ */
+void runActivity(int *happiness, int count, int min, int subtraction, int add);
+
+#endif
@@ -0,0 +1,177 @@
+#include "HashFunctions.h"
+
+static const uint64_t wyp[4] = {0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL,
+    0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL};
+
+static void wymum(uint64_t *a, uint64_t *b) {
+#ifdef __SIZEOF_INT128__
+    __uint128_t r = (__uint128_t) *a * *b;
+    *a = (uint64_t) r;
+    *b = (uint64_t) (r >> 64);
+#else
+    uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t) *a, lb = (uint32_t) *b;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+static uint64_t wymix(uint64_t a, uint64_t b) {
+    wymum(&a, &b);
+    return a ^ b;
+}
+
+static uint64_t read64(const unsigned char *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static uint64_t read32(const unsigned char *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static uint64_t read_small(const unsigned char *p, size_t k) {
+    return (((uint64_t) p[0]) << 16) | (((uint64_t) p[k >> 1]) << 8) | p[k - 1];
+}
+
+uint64_t wyhashBytes(const void *data, size_t len, uint64_t seed) {
+    const unsigned char *p = (const unsigned char *) data;
+    uint64_t a, b;
+    seed ^= wymix(seed ^ wyp[0], wyp[1]);
+    if (len <= 16) {
+        if (len >= 4) {
+            a = (read32(p) << 32) | read32(p + ((len >> 3) << 2));
+            b = (read32(p + len - 4) << 32) | read32(p + len - 4 - ((len >> 3) << 2));
+        } else if (len > 0) {
+            a = read_small(p, len);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = len;
+        if (i >= 48) {
+            uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = wymix(read64(p) ^ wyp[1], read64(p + 8) ^ seed);
+                see1 = wymix(read64(p + 16) ^ wyp[2], read64(p + 24) ^ see1);
+                see2 = wymix(read64(p + 32) ^ wyp[3], read64(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i >= 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = wymix(read64(p) ^ wyp[1], read64(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = read64(p + i - 16);
+        b = read64(p + i - 8);
+    }
+    a ^= wyp[1];
+    b ^= seed;
+    wymum(&a, &b);
+    return wymix(a ^ wyp[0] ^ len, b ^ wyp[1]);
+}
+
+uint64_t wyhashString(Element key, uint64_t seed) {
+    if (key == NULL) return 0;
+    return wyhashBytes(key, strlen((char *) key), seed);
+}
+
+#define ROTL(x, b) (uint64_t) (((x) << (b)) | ((x) >> (64 - (b))))
+
+#define SIPROUND \
+    do { \
+        v0 += v1; v1 = ROTL(v1, 13); v1 ^= v0; v0 = ROTL(v0, 32); \
+        v2 += v3; v3 = ROTL(v3, 16); v3 ^= v2; \
+        v0 += v3; v3 = ROTL(v3, 21); v3 ^= v0; \
+        v2 += v1; v1 = ROTL(v1, 17); v1 ^= v2; v2 = ROTL(v2, 32); \
+    } while (0)
+
+uint64_t sipHashString(Element key, uint64_t seed) {
+    if (key == NULL) return 0;
+    const unsigned char *p = (const unsigned char *) key;
+    size_t len = strlen((char *) key);
+    uint64_t k0 = seed;
+    uint64_t k1 = ROTL(seed, 32) ^ wyp[0];
+    uint64_t v0 = 0x736f6d6570736575ULL ^ k0;
+    uint64_t v1 = 0x646f72616e646f6dULL ^ k1;
+    uint64_t v2 = 0x6c7967656e657261ULL ^ k0;
+    uint64_t v3 = 0x7465646279746573ULL ^ k1;
+    const unsigned char *end = p + len - (len % 8);
+    for (; p != end; p += 8) {
+        uint64_t m = read64(p);
+        v3 ^= m;
+        SIPROUND;
+        SIPROUND;
+        v0 ^= m;
+    }
+    uint64_t b = ((uint64_t) len) << 56;
+    for (size_t i = 0; i < len % 8; i++) {
+        b |= ((uint64_t) p[i]) << (8 * i);
+    }
+    v3 ^= b;
+    SIPROUND;
+    SIPROUND;
+    v0 ^= b;
+    v2 ^= 0xff;
+    SIPROUND;
+    SIPROUND;
+    SIPROUND;
+    SIPROUND;
+    return v0 ^ v1 ^ v2 ^ v3;
+}
+
+uint64_t sumHashString(Element key, uint64_t seed) {
+    if (key == NULL) return 0;
+    const unsigned char *str = (const unsigned char *) key;
+    uint64_t res = seed;
+    while (*str) {
+        res = res + *str;
+        str++;
+    }
+    return res;
+}
+
+status displayChainLengthReport(Element *keys, int keysNum, HashFunction hash, uint64_t seed, int buckets) {
+    if (keys == NULL || hash == NULL || keysNum < 0 || buckets <= 0) return failure;
+    int *chains = (int *) calloc(buckets, sizeof(int));
+    if (chains == NULL) return failure;
+    int longest = 0;
+    for (int i = 0; i < keysNum; i++) {
+        int idx = (int) (hash(keys[i], seed) % (uint64_t) buckets);
+        chains[idx]++;
+        if (chains[idx] > longest) longest = chains[idx];
+    }
+    int *histogram = (int *) calloc(longest + 1, sizeof(int));
+    if (histogram == NULL) {
+        free(chains);
+        return failure;
+    }
+    double comparisons = 0;
+    for (int i = 0; i < buckets; i++) {
+        histogram[chains[i]]++;
+        comparisons += (double) chains[i] * (chains[i] + 1) / 2;
+    }
+    printf("Chain length report : %d keys in %d buckets (load factor %.2f) \n",
+        keysNum, buckets, (double) keysNum / buckets);
+    for (int len = 0; len <= longest; len++) {
+        if (histogram[len] > 0) {
+            printf("\t%d : %d buckets \n", len, histogram[len]);
+        }
+    }
+    printf("Longest chain : %d \n", longest);
+    printf("Average comparisons per successful lookup : %.2f \n", keysNum > 0 ? comparisons / keysNum : 0.0);
+    free(histogram);
+    free(chains);
+    return success;
+}
@@ -0,0 +1,87 @@
+#ifndef HASH_FUNCTIONS_H
+#define HASH_FUNCTIONS_H
+#include "Defs.h"
+
+/**
+ * @brief Seed used by tables that were not given one explicitly.
+ */
+#define DEFAULT_HASH_SEED 0x9E3779B97F4A7C15ULL
+
+/**
+ * @brief Hashes a block of memory with a wyhash style function.
+ *
+ * The bytes are consumed 16 (or 48) at a time and mixed with 64x64->128 bit multiplications,
+ * which makes the function both fast and well distributed. Different seeds produce unrelated
+ * hash values for the same input.
+ *
+ * @param data Pointer to the bytes to hash.
+ * @param len The number of bytes to hash.
+ * @param seed The seed of the hash function.
+ *
+ * @return The 64 bit hash of the bytes.
+ */
+uint64_t wyhashBytes(const void *data, size_t len, uint64_t seed);
+/**
+ * @brief Hashes a null terminated string with a wyhash style function.
+ *
+ * This function matches the `HashFunction` type, so it can be given directly to
+ * `createHashTable` and `createMultiValueHashTable` for string keys.
+ *
+ * @param key The string to hash (as an element).
+ * @param seed The seed of the hash function.
+ *
+ * @return
+ * - The 64 bit hash of the string.
+ * - `0` if the key is `NULL`.
+ */
+uint64_t wyhashString(Element key, uint64_t seed);
+/**
+ * @brief Hashes a null terminated string with SipHash-2-4.
+ *
+ * SipHash is slower than `wyhashString` but is a keyed pseudo random function: without the
+ * seed, an attacker can not construct keys that collide. The 128 bit SipHash key is derived
+ * from the 64 bit seed.
+ *
+ * @param key The string to hash (as an element).
+ * @param seed The seed of the hash function.
+ *
+ * @return
+ * - The 64 bit hash of the string.
+ * - `0` if the key is `NULL`.
+ */
+uint64_t sipHashString(Element key, uint64_t seed);
+/**
+ * @brief Hashes a null terminated string by adding up its characters.
+ *
+ * This is the hash the daycare used originally. Anagrams always collide, so it is only
+ * kept as a baseline for `displayChainLengthReport`.
+ *
+ * @param key The string to hash (as an element).
+ * @param seed Added to the sum of the characters.
+ *
+ * @return
+ * - The sum of the (unsigned) characters of the string plus the seed.
+ * - `0` if the key is `NULL`.
+ */
+uint64_t sumHashString(Element key, uint64_t seed);
+/**
+ * @brief Prints how a set of keys would spread over the buckets of a chained hash table.
+ *
+ * This function hashes every key, distributes the keys over `buckets` buckets the way
+ * `hashTable` does, and prints a histogram of the chain lengths together with the longest
+ * chain and the average number of comparisons of a successful lookup. Running it with
+ * different hash functions over a real set of keys shows which one spreads them best.
+ *
+ * @param keys Array of the keys to distribute.
+ * @param keysNum The number of keys in the array.
+ * @param hash The hash function to evaluate.
+ * @param seed The seed passed to the hash function.
+ * @param buckets The number of buckets to distribute the keys over.
+ *
+ * @return
+ * - `success` if the report is printed.
+ * - `failure` if an argument is invalid or memory allocation fails.
+ */
+status displayChainLengthReport(Element *keys, int keysNum, HashFunction hash, uint64_t seed, int buckets);
+
+#endif
@@ -1,10 +1,54 @@
 #include"HashTable.h"
 #include "LinkedList.h"
 #include "KeyValuePair.h"
+#include "HashFunctions.h"
+#include "PairTree.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief A single entry of the open addressing engine.
+ *
+ * Slots are stored in one flat array. Whether a slot is in use is recorded in the
+ * parallel array of control bytes, never in the slot itself. The full hash of the key
+ * is kept next to it, so resizes never hash a key again and a probe only calls
+ * `equalKey` when the whole hash matches.
+ */
+typedef struct oa_slot {
+    Element key;
+    Element value;
+    uint64_t hash;
+} oa_slot;
+
+/**
+ * @brief A slot array of the open addressing engine together with its control bytes.
+ *
+ * Every slot has one control byte: `CTRL_EMPTY`, `CTRL_DELETED`, or, for a slot in use,
+ * the low 7 bits of the key's hash (its tag). `used` counts slots that are in use or
+ * deleted, since both lengthen probe sequences.
+ */
+typedef struct oa_array {
+    signed char *ctrl;
+    oa_slot *slots;
+    int used;
+} oa_array;
 
 struct hashTable_s {
+    hashTableEngine engine;
     int size;
     linked_list *table;
+    oa_array slots;
+    int newSize;
+    linked_list *newTable;
+    pair_tree *trees;
+    pair_tree *newTrees;
+    oa_array newSlots;
+    int rehashIdx;
+    int count;
+    int minSize;
+    float maxLoadFactor;
+    float minLoadFactor;
     CopyFunction copyKey;
     FreeFunction freeKey;
     PrintFunction printKey;
@@ -12,22 +56,97 @@ struct hashTable_s {
     FreeFunction freeValue;
     PrintFunction printValue;
     EqualFunction equalKey;
-    TransformIntoNumberFunction transformIntoNumber;
+    CompareFunction compareKey;
+    HashFunction hashKey;
+    uint64_t seed;
+    key_value_type pairType;
+    const allocator *alloc;
+#ifndef HASH_TABLE_NO_STATS
+    int probes;
+    long hits;
+    long misses;
+    long hitProbes;
+    long missProbes;
+    long resizes;
+#endif
 };
 
 /**
- * @brief Computes the hash index for a key in the hash table.
+ * @brief Default load factors used until `setHashTableLoadFactors` is called.
+ *
+ * The table grows when the number of pairs per bucket exceeds the maximum load factor and
+ * shrinks (never below the bucket count it was created with) when it drops under the minimum.
+ * The open addressing engine must keep free slots to end its probes, so its maximum is lower.
+ */
+#define DEFAULT_MAX_LOAD_FACTOR 1.0f
+#define DEFAULT_OA_MAX_LOAD_FACTOR 0.875f
+#define DEFAULT_MIN_LOAD_FACTOR 0.125f
+
+/**
+ * @brief Number of buckets (or groups of slots) migrated to the new bucket array by every
+ * operation while the table is being resized. Empty buckets are skipped up to ten times this
+ * amount per step.
+ */
+#define REHASH_STEP 4
+
+/**
+ * @brief Control bytes of the open addressing engine.
+ *
+ * Slots are probed in groups of `GROUP_WIDTH`, and all control bytes of a group are
+ * compared against a tag at once. Both special values have their high bit set, which
+ * tells them apart from the 7 bit tags of slots in use.
+ */
+#define GROUP_WIDTH 16
+#define CTRL_EMPTY ((signed char) 0x80)
+#define CTRL_DELETED ((signed char) 0xFE)
+
+/**
+ * @brief Chain lengths at which a bucket of the chaining engine turns into a balanced tree
+ * and back into a list. The gap between them keeps a bucket from switching back and forth.
+ */
+#define TREEIFY_THRESHOLD 8
+#define UNTREEIFY_THRESHOLD 6
+
+/**
+ * @brief Runs a statement that updates the search counters, unless the table is built
+ * with `HASH_TABLE_NO_STATS`, in which case the counters do not exist.
+ */
+#ifndef HASH_TABLE_NO_STATS
+#define STAT(statement) statement
+#else
+#define STAT(statement)
+#endif
+
+/**
+ * @brief Number of keys the batched operations hash and prefetch before resolving any of them.
+ *
+ * The cache misses of a whole batch are in flight together instead of one after another,
+ * which is where the batched operations gain over a loop of single lookups.
+ */
+#define HASH_BATCH 16
+
+/**
+ * @brief Hints the processor to start loading the cache line holding an address.
+ */
+#if defined(__GNUC__)
+#define PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define PREFETCH(addr) ((void) (addr))
+#endif
+
+/**
+ * @brief Computes the bucket index of a hash in a bucket array.
  *
- * This macro calculates the bucket index by transforming the key into a number
- * and taking the modulus with the hash table's size.
+ * This macro calculates the bucket index by taking the modulus of the key's hash
+ * (see `key_hash`) with the given number of buckets.
  *
- * @param table Pointer to the hash table.
- * @param key The key to compute the hash index for.
+ * @param hash The hash of the key.
+ * @param buckets The number of buckets in the bucket array being addressed.
  *
  * @return The index of the bucket where the key maps.
  */
-#define hash_func(table ,key) \
-    ((int) (table->transformIntoNumber(key)%table->size))
+#define hash_func(hash, buckets) \
+    ((int) ((hash) % (uint64_t) (buckets)))
 
 
 Element copy_kvp(Element kvp) {
@@ -97,20 +216,950 @@ static linked_list create_kvp_list(hashTable t) {
  *
  * @note This is an internal helper function for integrating key-value pairs with the hash table.
  */
-    return createLinkedList(copy_kvp, t->equalKey, print_kvp, destroy_kvp, kvp_get_key);
+    return createLinkedListWithAllocator(copy_kvp, t->equalKey, print_kvp, destroy_kvp, kvp_get_key, t->alloc);
+}
+
+static int next_table_prime(int number) {
+    /**
+ * @brief Finds the smallest prime number that is greater than or equal to the given number.
+ *
+ * @param number The lower bound for the prime number.
+ * @return The smallest prime number that is not smaller than `number` (at least 2).
+ *
+ * @note Prime bucket counts keep the modulus in `hash_func` spreading hashes over all buckets.
+ */
+    if (number <= 2) return 2;
+    if (number % 2 == 0) number++;
+    while (true) {
+        bool prime = true;
+        for (int i = 3; i <= number / i; i += 2) {
+            if (number % i == 0) {
+                prime = false;
+                break;
+            }
+        }
+        if (prime) return number;
+        number += 2;
+    }
+}
+
+static int next_power_of_two(int number) {
+    /**
+ * @brief Finds the smallest power of two that is greater than or equal to the given number.
+ *
+ * @param number The lower bound for the power of two.
+ * @return The smallest power of two that is not smaller than `number` (at least `GROUP_WIDTH`).
+ *
+ * @note The open addressing engine masks hashes instead of taking a modulus, so its
+ *       slot arrays always hold a power of two number of slots.
+ */
+    int power = GROUP_WIDTH;
+    while (power < number) {
+        power *= 2;
+    }
+    return power;
+}
+
+static bool is_rehashing(hashTable t) {
+    return t->newSize != 0;
+}
+
+static uint64_t key_hash(hashTable t, Element key) {
+    /**
+ * @brief Computes the 64 bit hash the table stores and probes with for a key.
+ *
+ * Every operation hashes its key once with `hashKey` and the table's seed. The open
+ * addressing engine additionally passes the hash through a 64 bit finalizer, so that both
+ * the group index (high bits) and the 7 bit tag (low bits) depend on every bit of it,
+ * even for weak hash functions.
+ *
+ * @param t The hash table.
+ * @param key The key to hash.
+ * @return The hash of the key.
+ */
+    uint64_t h = t->hashKey(key, t->seed);
+    if (t->engine != openAddressingEngine) return h;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+static unsigned int group_match(const signed char *ctrl, signed char tag) {
+    /**
+ * @brief Compares all control bytes of a group against a value.
+ *
+ * With SSE2 the 16 control bytes are compared in a single instruction, otherwise
+ * they are compared one by one.
+ *
+ * @param ctrl Pointer to the first control byte of the group.
+ * @param tag The value to look for.
+ * @return A bit mask with bit `i` set when control byte `i` equals `tag`.
+ */
+#ifdef __SSE2__
+    __m128i group = _mm_loadu_si128((const __m128i *) ctrl);
+    return (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(tag)));
+#else
+    unsigned int mask = 0;
+    for (int i = 0; i < GROUP_WIDTH; i++) {
+        if (ctrl[i] == tag) mask |= 1u << i;
+    }
+    return mask;
+#endif
+}
+
+static unsigned int group_match_free(const signed char *ctrl) {
+    /**
+ * @brief Finds the empty and deleted slots of a group.
+ *
+ * @param ctrl Pointer to the first control byte of the group.
+ * @return A bit mask with bit `i` set when slot `i` of the group is not in use.
+ */
+#ifdef __SSE2__
+    return (unsigned int) _mm_movemask_epi8(_mm_loadu_si128((const __m128i *) ctrl));
+#else
+    unsigned int mask = 0;
+    for (int i = 0; i < GROUP_WIDTH; i++) {
+        if (ctrl[i] < 0) mask |= 1u << i;
+    }
+    return mask;
+#endif
+}
+
+static int lowest_bit(unsigned int mask) {
+#if defined(__GNUC__)
+    return __builtin_ctz(mask);
+#else
+    int i = 0;
+    while ((mask & 1u) == 0) {
+        mask >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+static status oa_alloc(oa_array *a, int capacity) {
+    /**
+ * @brief Allocates an empty slot array with room for `capacity` slots.
+ *
+ * @param a The slot array to initialize.
+ * @param capacity The number of slots, a power of two.
+ * @return
+ * - `success` if the arrays are allocated.
+ * - `failure` if memory allocation fails.
+ */
+    a->ctrl = (signed char*)malloc(capacity);
+    a->slots = (oa_slot*)malloc(sizeof(oa_slot) * capacity);
+    if (a->ctrl == NULL || a->slots == NULL) {
+        free(a->ctrl);
+        free(a->slots);
+        a->ctrl = NULL;
+        a->slots = NULL;
+        return failure;
+    }
+    memset(a->ctrl, CTRL_EMPTY, capacity);
+    a->used = 0;
+    return success;
+}
+
+static void oa_free(oa_array *a) {
+    free(a->ctrl);
+    free(a->slots);
+    a->ctrl = NULL;
+    a->slots = NULL;
+    a->used = 0;
+}
+
+static int oa_find(hashTable t, oa_array *a, int capacity, Element key, uint64_t h, int *freeSlot) {
+    /**
+ * @brief Finds the slot holding a key in a slot array of the open addressing engine.
+ *
+ * Groups are visited in triangular order starting at the group chosen by the high bits
+ * of the hash, which visits every group once when the number of groups is a power of two.
+ * Only slots whose tag matches the low 7 bits of the hash are compared with `equalKey`,
+ * and the probe ends at the first group that still has an empty slot.
+ * On the way the probe notes the first free slot it passes, which is the slot `oa_claim`
+ * would pick, so an insertion after a failed search does not have to probe again.
+ *
+ * @param t The hash table.
+ * @param a The slot array to search.
+ * @param capacity The number of slots in the array.
+ * @param key The key to search for.
+ * @param h The hash of the key (see `key_hash`).
+ * @param freeSlot Output parameter receiving the first free slot on the probe sequence,
+ *                 or `-1` if there is none (may be `NULL`).
+ * @return
+ * - The index of the slot holding the key.
+ * - `-1` if the key is not in the array.
+ */
+    int groups = capacity / GROUP_WIDTH;
+    int g = (int) ((h >> 7) & (uint64_t) (groups - 1));
+    signed char tag = (signed char) (h & 0x7F);
+    if (freeSlot != NULL) *freeSlot = -1;
+    for (int probe = 0; probe < groups; probe++) {
+        signed char *ctrl = a->ctrl + g * GROUP_WIDTH;
+        unsigned int match = group_match(ctrl, tag);
+        STAT(t->probes++);
+        while (match != 0) {
+            int i = g * GROUP_WIDTH + lowest_bit(match);
+            if (a->slots[i].hash == h && t->equalKey(a->slots[i].key, key) == true) return i;
+            match &= match - 1;
+        }
+        if (freeSlot != NULL && *freeSlot < 0) {
+            unsigned int avail = group_match_free(ctrl);
+            if (avail != 0) *freeSlot = g * GROUP_WIDTH + lowest_bit(avail);
+        }
+        if (group_match(ctrl, CTRL_EMPTY) != 0) return -1;
+        g = (g + probe + 1) & (groups - 1);
+    }
+    return -1;
+}
+
+static void oa_take(oa_array *a, int i, uint64_t h) {
+    /**
+ * @brief Marks a free slot as holding a key with the given hash.
+ *
+ * @param a The slot array.
+ * @param i The index of a free slot.
+ * @param h The hash of the key that is stored in the slot.
+ */
+    if (a->ctrl[i] == CTRL_EMPTY) a->used++;
+    a->ctrl[i] = (signed char) (h & 0x7F);
+    a->slots[i].hash = h;
+}
+
+static int oa_claim(oa_array *a, int capacity, uint64_t h) {
+    /**
+ * @brief Claims the first free slot on the probe sequence of a hash.
+ *
+ * The returned slot is marked with the hash's tag, counted as used and given the hash;
+ * the caller fills in its key and value.
+ *
+ * @param a The slot array to insert into.
+ * @param capacity The number of slots in the array.
+ * @param h The hash of the key being inserted.
+ * @return
+ * - The index of the claimed slot.
+ * - `-1` if the array has no free slot.
+ */
+    int groups = capacity / GROUP_WIDTH;
+    int g = (int) ((h >> 7) & (uint64_t) (groups - 1));
+    for (int probe = 0; probe < groups; probe++) {
+        unsigned int match = group_match_free(a->ctrl + g * GROUP_WIDTH);
+        if (match != 0) {
+            int i = g * GROUP_WIDTH + lowest_bit(match);
+            oa_take(a, i, h);
+            return i;
+        }
+        g = (g + probe + 1) & (groups - 1);
+    }
+    return -1;
+}
+
+static void treeify(hashTable t, linked_list *buckets, pair_tree *trees, int idx) {
+    /**
+ * @brief Turns a bucket of the chaining engine into a balanced tree once its chain is too long.
+ *
+ * Colliding keys make chains grow however the table is sized, so long chains are replaced by
+ * a tree ordered by hash (and by `compareKey` if the table has one), which bounds searches at
+ * O(log n). Either the whole bucket is converted or, if memory allocation fails, nothing is.
+ *
+ * @param t The hash table.
+ * @param buckets The bucket array holding the bucket.
+ * @param trees The tree array parallel to `buckets`.
+ * @param idx The index of the bucket.
+ */
+    linked_list bucket = buckets[idx];
+    if (getLengthList(bucket) <= TREEIFY_THRESHOLD) return;
+    pair_tree tree = createPairTree(t->equalKey, t->compareKey, print_kvp);
+    if (tree == NULL) return;
+    Element elem;
+    list_forEach(elem, bucket) {
+        if (insertToPairTree(tree, elem) == failure) {
+            //the pairs still belong to the list, empty the tree without destroying them
+            while (popFromPairTree(tree) != NULL);
+            destroyPairTree(tree);
+            return;
+        }
+    }
+    while (popHeadNode(bucket) != NULL);
+    destroyList(bucket);
+    buckets[idx] = NULL;
+    trees[idx] = tree;
+}
+
+static void untreeify(hashTable t, linked_list *buckets, pair_tree *trees, int idx) {
+    /**
+ * @brief Turns a tree bucket back into a chain once it holds few enough pairs.
+ *
+ * @param t The hash table.
+ * @param buckets The bucket array holding the bucket.
+ * @param trees The tree array parallel to `buckets`.
+ * @param idx The index of the bucket.
+ */
+    pair_tree tree = trees[idx];
+    if (getPairTreeSize(tree) > UNTREEIFY_THRESHOLD) return;
+    linked_list bucket = create_kvp_list(t);
+    if (bucket == NULL) return;
+    while (getPairTreeSize(tree) > 0) {
+        key_value_pair kvp = popFromPairTree(tree);
+        if (appendNode(bucket, kvp) == failure) {
+            //give everything back to the tree, whose nodes were just freed
+            insertToPairTree(tree, kvp);
+            while (getLengthList(bucket) > 0) insertToPairTree(tree, popHeadNode(bucket));
+            destroyList(bucket);
+            return;
+        }
+    }
+    destroyPairTree(tree);
+    trees[idx] = NULL;
+    buckets[idx] = getLengthList(bucket) > 0 ? bucket : NULL;
+    if (buckets[idx] == NULL) destroyList(bucket);
+}
+
+static status place_pair(hashTable t, linked_list *buckets, pair_tree *trees, int idx, key_value_pair kvp) {
+    /**
+ * @brief Adds an existing pair to a bucket of the chaining engine, whether it is a chain or a tree.
+ *
+ * @param t The hash table.
+ * @param buckets The bucket array.
+ * @param trees The tree array parallel to `buckets`.
+ * @param idx The index of the bucket.
+ * @param kvp The pair, which must carry its hash.
+ *
+ * @return
+ * - `success` if the pair is added.
+ * - `failure` if memory allocation fails.
+ */
+    if (trees[idx] != NULL) return insertToPairTree(trees[idx], kvp);
+    if (buckets[idx] == NULL) {
+        buckets[idx] = create_kvp_list(t);
+        if (buckets[idx] == NULL) return failure;
+    }
+    if (appendNode(buckets[idx], kvp) == failure) {
+        if (getLengthList(buckets[idx]) == 0) {
+            destroyList(buckets[idx]);
+            buckets[idx] = NULL;
+        }
+        return failure;
+    }
+    treeify(t, buckets, trees, idx);
+    return success;
+}
+
+static void start_resize(hashTable t, int newSize) {
+    /**
+ * @brief Starts moving the hash table into a bucket array of a different size.
+ *
+ * Only the new (empty) bucket array is allocated here. The pairs themselves are moved a few
+ * buckets at a time by `rehash_step`, so no single operation pays for the whole resize.
+ * Buckets are created lazily, which keeps the allocation itself cheap as well.
+ *
+ * @param t The hash table to resize.
+ * @param newSize The number of buckets (or slots) in the new bucket array.
+ *
+ * @note If the new bucket array can not be allocated the table simply keeps its current size.
+ */
+    if (is_rehashing(t)) return;
+    if (t->engine == openAddressingEngine) {
+        if (oa_alloc(&t->newSlots, newSize) == failure) return;
+    } else {
+        t->newTable = (linked_list*)calloc(newSize, sizeof(linked_list));
+        t->newTrees = (pair_tree*)calloc(newSize, sizeof(pair_tree));
+        if (t->newTable == NULL || t->newTrees == NULL) {
+            free(t->newTable);
+            free(t->newTrees);
+            t->newTable = NULL;
+            t->newTrees = NULL;
+            return;
+        }
+    }
+    t->newSize = newSize;
+    t->rehashIdx = 0;
+    STAT(t->resizes++);
+}
+
+static void finish_resize(hashTable t) {
+    /**
+ * @brief Releases the old bucket array once every pair has been moved out of it.
+ *
+ * @param t The hash table being resized.
+ */
+    if (t->engine == openAddressingEngine) {
+        oa_free(&t->slots);
+        t->slots = t->newSlots;
+        t->newSlots.ctrl = NULL;
+        t->newSlots.slots = NULL;
+        t->newSlots.used = 0;
+    } else {
+        free(t->table);
+        free(t->trees);
+        t->table = t->newTable;
+        t->trees = t->newTrees;
+        t->newTable = NULL;
+        t->newTrees = NULL;
+    }
+    t->size = t->newSize;
+    t->newSize = 0;
+    t->rehashIdx = 0;
+}
+
+static void chain_rehash_step(hashTable t, int steps) {
+    /**
+ * @brief Moves up to `steps` buckets from the old bucket array to the new one.
+ *
+ * Every pair of a migrated bucket is relinked into its bucket in the new array without
+ * copying, reallocating or hashing it again.
+ *
+ * @param t The hash table being resized.
+ * @param steps The maximum number of non empty buckets to migrate.
+ */
+    int emptyVisits = steps * 10;
+    while (steps > 0 && t->rehashIdx < t->size) {
+        linked_list bucket = t->table[t->rehashIdx];
+        pair_tree tree = t->trees[t->rehashIdx];
+        if (bucket == NULL && tree == NULL) {
+            t->rehashIdx++;
+            if (--emptyVisits == 0) break;
+            continue;
+        }
+        while (getLengthList(bucket) > 0) {
+            Element kvp = listHead(bucket);
+            int idx = hash_func(getKeyHash((key_value_pair) kvp), t->newSize);
+            if (t->newTrees[idx] != NULL) {
+                if (insertToPairTree(t->newTrees[idx], kvp) == failure) return;
+                popHeadNode(bucket);
+                continue;
+            }
+            if (t->newTable[idx] == NULL) {
+                t->newTable[idx] = create_kvp_list(t);
+                if (t->newTable[idx] == NULL) return;
+            }
+            transferHeadNode(bucket, t->newTable[idx]);
+            treeify(t, t->newTable, t->newTrees, idx);
+        }
+        while (getPairTreeSize(tree) > 0) {
+            key_value_pair kvp = popFromPairTree(tree);
+            if (place_pair(t, t->newTable, t->newTrees, hash_func(getKeyHash(kvp), t->newSize), kvp) == failure) {
+                insertToPairTree(tree, kvp);
+                return;
+            }
+        }
+        destroyList(bucket);
+        destroyPairTree(tree);
+        t->table[t->rehashIdx] = NULL;
+        t->trees[t->rehashIdx] = NULL;
+        t->rehashIdx++;
+        steps--;
+    }
+}
+
+static void oa_rehash_step(hashTable t, int steps) {
+    /**
+ * @brief Moves up to `steps` groups of slots from the old slot array to the new one.
+ *
+ * Migrated slots are marked as deleted rather than empty, so probes for keys that are
+ * still waiting in later groups of the old array keep working.
+ *
+ * @param t The hash table being resized.
+ * @param steps The maximum number of groups to migrate.
+ */
+    int groups = t->size / GROUP_WIDTH;
+    while (steps > 0 && t->rehashIdx < groups) {
+        for (int i = t->rehashIdx * GROUP_WIDTH; i < (t->rehashIdx + 1) * GROUP_WIDTH; i++) {
+            if (t->slots.ctrl[i] < 0) continue;
+            int j = oa_claim(&t->newSlots, t->newSize, t->slots.slots[i].hash);
+            if (j < 0) return;
+            t->newSlots.slots[j] = t->slots.slots[i];
+            t->slots.ctrl[i] = CTRL_DELETED;
+        }
+        t->rehashIdx++;
+        steps--;
+    }
+}
+
+static void rehash_step(hashTable t, int steps) {
+    /**
+ * @brief Advances an ongoing resize by a few buckets.
+ *
+ * When the last bucket has been migrated the old array is released and the new array
+ * becomes the table.
+ *
+ * @param t The hash table being resized.
+ * @param steps The maximum number of buckets (or groups of slots) to migrate.
+ */
+    if (t->engine == openAddressingEngine) {
+        oa_rehash_step(t, steps);
+        if (t->rehashIdx < t->size / GROUP_WIDTH) return;
+    } else {
+        chain_rehash_step(t, steps);
+        if (t->rehashIdx < t->size) return;
+    }
+    finish_resize(t);
+}
+
+static void check_load(hashTable t) {
+    /**
+ * @brief Starts growing or shrinking the table when its load factor leaves the configured range.
+ *
+ * The open addressing engine also counts deleted slots, and rebuilds a table at its current
+ * size when they alone push it over the maximum load factor.
+ *
+ * @param t The hash table to check.
+ */
+    if (is_rehashing(t)) return;
+    bool open = t->engine == openAddressingEngine;
+    if (t->count > t->maxLoadFactor * t->size) {
+        start_resize(t, open ? t->size * 2 : next_table_prime(t->size * 2));
+    } else if (open && t->slots.used > t->maxLoadFactor * t->size) {
+        start_resize(t, t->size);
+    } else if (t->size > t->minSize && t->count < t->minLoadFactor * t->size) {
+        int newSize = open ? t->size / 2 : next_table_prime(t->size / 2);
+        if (newSize < t->minSize) newSize = t->minSize;
+        if (newSize != t->size) start_resize(t, newSize);
+    }
+}
+
+static key_value_pair chain_search(hashTable t, linked_list bucket, Element key, uint64_t h) {
+    /**
+ * @brief Searches one bucket for the key-value pair stored under a key.
+ *
+ * Each pair remembers the hash of its key, so pairs with a different hash are skipped
+ * with a single integer comparison and `equalKey` only runs on real candidates.
+ *
+ * @param t The hash table.
+ * @param bucket The bucket to search (may be `NULL`).
+ * @param key The key to search for.
+ * @param h The hash of the key (see `key_hash`).
+ *
+ * @return
+ * - The key-value pair stored under the key.
+ * - `NULL` if the key is not in the bucket.
+ */
+    if (getLengthList(bucket) == 0) return NULL;
+    Element elem;
+    list_forEach(elem, bucket) {
+        key_value_pair kvp = (key_value_pair) elem;
+        STAT(t->probes++);
+        if (getKeyHash(kvp) == h && t->equalKey(get_shallow_key(kvp), key) == true) return kvp;
+    }
+    return NULL;
+}
+
+#ifndef HASH_TABLE_NO_STATS
+static void record_search(hashTable t, bool hit) {
+    /**
+ * @brief Adds the probes counted by the last search to the hit or miss counters.
+ */
+    if (hit) {
+        t->hits++;
+        t->hitProbes += t->probes;
+    } else {
+        t->misses++;
+        t->missProbes += t->probes;
+    }
+}
+#endif
+
+static key_value_pair bucket_search(hashTable t, linked_list bucket, pair_tree tree, Element key, uint64_t h) {
+    /**
+ * @brief Searches one bucket of the chaining engine, a chain or a tree, for a key.
+ */
+    if (tree == NULL) return chain_search(t, bucket, key, h);
+    int visited;
+    key_value_pair kvp = searchPairTree(tree, key, h, &visited);
+    STAT(t->probes += visited);
+    return kvp;
+}
+
+static key_value_pair find_pair(hashTable t, Element key, uint64_t h, bool *inNew) {
+    /**
+ * @brief Finds the key-value pair stored under a key in either bucket array.
+ *
+ * @param t The hash table to search.
+ * @param key The key to search for.
+ * @param h The hash of the key (see `key_hash`).
+ * @param inNew Output parameter set to `true` if the pair is in the new bucket array of
+ *              an ongoing resize (may be `NULL`).
+ *
+ * @return
+ * - The key-value pair stored under the key.
+ * - `NULL` if the key does not exist in the hash table.
+ */
+    int idx = hash_func(h, t->size);
+    key_value_pair kvp = bucket_search(t, t->table[idx], t->trees[idx], key, h);
+    bool found_new = false;
+    if (kvp == NULL && is_rehashing(t)) {
+        idx = hash_func(h, t->newSize);
+        kvp = bucket_search(t, t->newTable[idx], t->newTrees[idx], key, h);
+        found_new = true;
+    }
+    if (inNew != NULL) *inNew = found_new;
+    return kvp;
+}
+
+static status chain_remove(hashTable t, Element key, uint64_t h) {
+    /**
+ * @brief Removes and destroys the pair stored under a key in the chaining engine.
+ *
+ * A tree bucket that becomes small enough is turned back into a chain.
+ *
+ * @return
+ * - `success` if the pair is removed.
+ * - `failure` if the key does not exist in the hash table.
+ */
+    bool inNew;
+    key_value_pair kvp = find_pair(t, key, h, &inNew);
+    STAT(record_search(t, kvp != NULL));
+    if (kvp == NULL) return failure;
+    linked_list *buckets = inNew ? t->newTable : t->table;
+    pair_tree *trees = inNew ? t->newTrees : t->trees;
+    int idx = hash_func(h, inNew ? t->newSize : t->size);
+    if (trees[idx] == NULL) return deleteNode(buckets[idx], kvp);
+    destroyKeyValuePair(removeFromPairTree(trees[idx], key, h));
+    untreeify(t, buckets, trees, idx);
+    return success;
+}
+
+static oa_slot *find_slot(hashTable t, Element key, uint64_t h, oa_array **array) {
+    /**
+ * @brief Finds the slot holding a key in either slot array of the open addressing engine.
+ *
+ * @param t The hash table to search.
+ * @param key The key to search for.
+ * @param h The hash of the key (see `key_hash`).
+ * @param array Output parameter receiving the slot array that holds the key (may be `NULL`).
+ *
+ * @return
+ * - The slot holding the key.
+ * - `NULL` if the key does not exist in the hash table.
+ */
+    oa_array *a = &t->slots;
+    int i = oa_find(t, a, t->size, key, h, NULL);
+    if (i < 0 && is_rehashing(t)) {
+        a = &t->newSlots;
+        i = oa_find(t, a, t->newSize, key, h, NULL);
+    }
+    if (i < 0) return NULL;
+    if (array != NULL) *array = a;
+    return &a->slots[i];
+}
+
+static Element *oa_locate(hashTable t, Element key, uint64_t h, bool insert, bool *inserted) {
+    /**
+ * @brief Finds the value slot of a key in the open addressing engine, inserting the key if asked to.
+ *
+ * The key is searched in both slot arrays. The probe of the array new keys go to also
+ * remembers the first free slot, so an insertion reuses it instead of probing again.
+ *
+ * @param t The hash table.
+ * @param key The key to search for.
+ * @param h The hash of the key (see `key_hash`).
+ * @param insert Whether to insert the key when it is missing.
+ * @param inserted Output parameter set to `true` if the key was inserted.
+ *
+ * @return
+ * - The address of the value stored under the key. A newly inserted key has a `NULL` value.
+ * - `NULL` if the key is missing and was not inserted.
+ */
+    bool rehashing = is_rehashing(t);
+    int freeSlot = -1;
+    int i = oa_find(t, &t->slots, t->size, key, h, (insert && !rehashing) ? &freeSlot : NULL);
+    if (i >= 0) return &t->slots.slots[i].value;
+    if (rehashing) {
+        i = oa_find(t, &t->newSlots, t->newSize, key, h, insert ? &freeSlot : NULL);
+        if (i >= 0) return &t->newSlots.slots[i].value;
+    }
+    if (!insert || freeSlot < 0) return NULL;
+    oa_array *a = rehashing ? &t->newSlots : &t->slots;
+    Element copy = t->copyKey(key);
+    if (copy == NULL) return NULL;
+    oa_take(a, freeSlot, h);
+    a->slots[freeSlot].key = copy;
+    a->slots[freeSlot].value = NULL;
+    *inserted = true;
+    return &a->slots[freeSlot].value;
+}
+
+static Element *chain_locate(hashTable t, Element key, uint64_t h, bool insert, bool *inserted) {
+    /**
+ * @brief Finds the value slot of a key in the chaining engine, inserting the key if asked to.
+ *
+ * A new pair is only created once the key is known to be missing, and it holds a copy
+ * of the key alone.
+ *
+ * @param t The hash table.
+ * @param key The key to search for.
+ * @param h The hash of the key (see `key_hash`).
+ * @param insert Whether to insert the key when it is missing.
+ * @param inserted Output parameter set to `true` if the key was inserted.
+ *
+ * @return
+ * - The address of the value stored under the key. A newly inserted key has a `NULL` value.
+ * - `NULL` if the key is missing and was not inserted.
+ */
+    key_value_pair kvp = find_pair(t, key, h, NULL);
+    if (kvp != NULL) return getValueSlot(kvp);
+    if (!insert) return NULL;
+    kvp = createKeyOnlyPairOfType(key, t->pairType);
+    if (kvp == NULL) return NULL;
+    setKeyHash(kvp, h);
+    //while the table is being resized new pairs always go to the new bucket array
+    bool rehashing = is_rehashing(t);
+    status res = place_pair(t, rehashing ? t->newTable : t->table, rehashing ? t->newTrees : t->trees,
+        hash_func(h, rehashing ? t->newSize : t->size), kvp);
+    if (res == failure) {
+        destroyKeyValuePair(kvp);
+        return NULL;
+    }
+    *inserted = true;
+    return getValueSlot(kvp);
+}
+
+static Element *locate_hashed(hashTable t, Element key, uint64_t h, bool insert, bool *inserted) {
+    /**
+ * @brief Finds the address of the value of an already hashed key, inserting the key if asked to.
+ *
+ * When a key is inserted only the key is copied; the caller stores the value through the
+ * returned pointer. Starting a resize never moves existing entries, so the pointer stays
+ * valid until the next resize step.
+ *
+ * @param t The hash table.
+ * @param key The key to search for.
+ * @param h The hash of the key (see `key_hash`).
+ * @param insert Whether to insert the key when it is missing.
+ * @param inserted Output parameter set to `true` if the key was inserted (may be `NULL`).
+ *
+ * @return
+ * - The address of the value stored under the key. A newly inserted key has a `NULL` value.
+ * - `NULL` if the key is missing and was not inserted, or memory allocation fails.
+ */
+    bool added = false;
+    STAT(t->probes = 0);
+    Element *value = t->engine == openAddressingEngine ?
+        oa_locate(t, key, h, insert, &added) : chain_locate(t, key, h, insert, &added);
+    STAT(record_search(t, value != NULL && !added));
+    if (added) {
+        t->count++;
+        check_load(t);
+    }
+    if (inserted != NULL) *inserted = added;
+    return value;
+}
+
+static Element *locate_value(hashTable t, Element key, bool insert, bool *inserted) {
+    /**
+ * @brief Hashes a key once and finds the address of its value, inserting the key if asked to.
+ *
+ * This is the single search routine behind all single key lookups and insertions of the
+ * table. It runs a step of an ongoing resize first and then calls `locate_hashed`, so the
+ * returned pointer stays valid until the next operation on the table.
+ *
+ * @param t The hash table.
+ * @param key The key to search for.
+ * @param insert Whether to insert the key when it is missing.
+ * @param inserted Output parameter set to `true` if the key was inserted (may be `NULL`).
+ *
+ * @return
+ * - The address of the value stored under the key. A newly inserted key has a `NULL` value.
+ * - `NULL` if the key is missing and was not inserted, or memory allocation fails.
+ */
+    if (is_rehashing(t)) rehash_step(t, REHASH_STEP);
+    return locate_hashed(t, key, key_hash(t, key), insert, inserted);
+}
+
+static void prefetch_home(hashTable t, uint64_t h) {
+    /**
+ * @brief Prefetches the first memory a search for a hash touches.
+ *
+ * For the open addressing engine these are the control bytes and slots of the hash's first
+ * group, for the chaining engine the entry of the bucket array. While the table is being
+ * resized both arrays are prefetched.
+ *
+ * @param t The hash table.
+ * @param h The hash of a key that is about to be searched.
+ */
+    if (t->engine == openAddressingEngine) {
+        int g = (int) ((h >> 7) & (uint64_t) (t->size / GROUP_WIDTH - 1));
+        PREFETCH(t->slots.ctrl + g * GROUP_WIDTH);
+        PREFETCH(t->slots.slots + g * GROUP_WIDTH);
+        if (is_rehashing(t)) {
+            g = (int) ((h >> 7) & (uint64_t) (t->newSize / GROUP_WIDTH - 1));
+            PREFETCH(t->newSlots.ctrl + g * GROUP_WIDTH);
+            PREFETCH(t->newSlots.slots + g * GROUP_WIDTH);
+        }
+        return;
+    }
+    PREFETCH(&t->table[hash_func(h, t->size)]);
+    if (is_rehashing(t)) PREFETCH(&t->newTable[hash_func(h, t->newSize)]);
+}
+
+static void prefetch_bucket(hashTable t, uint64_t h) {
+    /**
+ * @brief Prefetches the bucket list of a hash once its bucket array entry is in the cache.
+ *
+ * Only the chaining engine keeps a second level to load; the slots of the open addressing
+ * engine are already covered by `prefetch_home`.
+ *
+ * @param t The hash table.
+ * @param h The hash of a key that is about to be searched.
+ */
+    if (t->engine == openAddressingEngine) return;
+    linked_list bucket = t->table[hash_func(h, t->size)];
+    if (bucket != NULL) PREFETCH(bucket);
+    if (is_rehashing(t)) {
+        bucket = t->newTable[hash_func(h, t->newSize)];
+        if (bucket != NULL) PREFETCH(bucket);
+    }
+}
+
+static int hash_batch(hashTable t, Element *keys, int n, uint64_t *hashes) {
+    /**
+ * @brief Prepares the next batch of a batched operation.
+ *
+ * Runs the resize steps the keys of the batch would have run one by one, hashes every key
+ * and prefetches the memory their searches start with, in two passes so the bucket arrays
+ * are loaded before the bucket lists they point to are requested.
+ *
+ * @param t The hash table.
+ * @param keys The remaining keys of the operation.
+ * @param n The number of remaining keys.
+ * @param hashes Output array of `HASH_BATCH` entries receiving the hashes of the batch.
+ *
+ * @return The number of keys in the batch.
+ */
+    int len = n < HASH_BATCH ? n : HASH_BATCH;
+    if (is_rehashing(t)) rehash_step(t, REHASH_STEP * len);
+    for (int i = 0; i < len; i++) {
+        hashes[i] = keys[i] == NULL ? 0 : key_hash(t, keys[i]);
+        if (keys[i] != NULL) prefetch_home(t, hashes[i]);
+    }
+    for (int i = 0; i < len; i++) {
+        if (keys[i] != NULL) prefetch_bucket(t, hashes[i]);
+    }
+    return len;
+}
+
+static void lookup_many(hashTable t, Element *keys, int n, Element *values, bool copy) {
+    /**
+ * @brief Looks up many keys batch by batch (see `hash_batch`).
+ *
+ * @param t The hash table.
+ * @param keys The keys to search for.
+ * @param n The number of keys.
+ * @param values Output array receiving the value of every key, or `NULL` for missing keys.
+ * @param copy Whether to return copies of the values instead of the stored values.
+ */
+    uint64_t hashes[HASH_BATCH];
+    while (n > 0) {
+        int len = hash_batch(t, keys, n, hashes);
+        for (int i = 0; i < len; i++) {
+            Element *value = keys[i] == NULL ? NULL : locate_hashed(t, keys[i], hashes[i], false, NULL);
+            if (value == NULL) values[i] = NULL;
+            else values[i] = copy ? t->copyValue(*value) : *value;
+        }
+        keys += len;
+        values += len;
+        n -= len;
+    }
+}
+
+static int oa_probe_length(oa_array *a, int capacity, int i) {
+    /**
+ * @brief Counts the groups a search visits before it reaches the key in slot `i`.
+ *
+ * @param a The slot array.
+ * @param capacity The number of slots in the array.
+ * @param i The index of a slot in use.
+ * @return The number of groups visited, 1 for a key in its home group.
+ */
+    int groups = capacity / GROUP_WIDTH;
+    int g = (int) ((a->slots[i].hash >> 7) & (uint64_t) (groups - 1));
+    int probe = 0;
+    while (g != i / GROUP_WIDTH && probe < groups) {
+        g = (g + probe + 1) & (groups - 1);
+        probe++;
+    }
+    return probe + 1;
+}
+
+static void scan_lengths(hashTable t, int *histogram, int length, hashTableStats *stats) {
+    /**
+ * @brief Walks the bucket arrays and collects the structural statistics of the table.
+ *
+ * For the chaining engine every bucket adds its number of pairs to the histogram. For the
+ * open addressing engine every key adds the number of groups it is displaced from its home
+ * group, and the longest chain is the longest probe in groups.
+ *
+ * @param t The hash table.
+ * @param histogram Array of `length` counters to add to (may be `NULL`).
+ * @param length The number of counters; the last one also counts all longer lengths.
+ * @param stats Receives `usedBuckets`, `tombstones` and `longestChain`.
+ */
+    stats->usedBuckets = 0;
+    stats->tombstones = 0;
+    stats->longestChain = 0;
+    for (int arr = 0; arr < 2; arr++) {
+        int capacity = arr == 0 ? t->size : t->newSize;
+        if (t->engine == openAddressingEngine) {
+            oa_array *a = arr == 0 ? &t->slots : &t->newSlots;
+            if (a->ctrl == NULL) continue;
+            for (int i = 0; i < capacity; i++) {
+                if (a->ctrl[i] == CTRL_DELETED) stats->tombstones++;
+                if (a->ctrl[i] < 0) continue;
+                stats->usedBuckets++;
+                int probes = oa_probe_length(a, capacity, i);
+                if (histogram != NULL) histogram[probes - 1 < length ? probes - 1 : length - 1]++;
+                if (probes > stats->longestChain) stats->longestChain = probes;
+            }
+            continue;
+        }
+        linked_list *buckets = arr == 0 ? t->table : t->newTable;
+        pair_tree *trees = arr == 0 ? t->trees : t->newTrees;
+        for (int i = 0; i < capacity; i++) {
+            int len = getLengthList(buckets[i]) + getPairTreeSize(trees[i]);
+            if (len > 0) stats->usedBuckets++;
+            if (histogram != NULL) histogram[len < length ? len : length - 1]++;
+            if (len > stats->longestChain) stats->longestChain = len;
+        }
+    }
+}
+
+static void oa_destroy_slots(hashTable t, oa_array *a, int capacity) {
+    if (a->ctrl == NULL) return;
+    for (int i = 0; i < capacity; i++) {
+        if (a->ctrl[i] < 0) continue;
+        t->freeKey(a->slots[i].key);
+        if (a->slots[i].value != NULL) t->freeValue(a->slots[i].value);
+    }
+    oa_free(a);
+}
+
+static void oa_display_slots(hashTable t, oa_array *a, int capacity) {
+    if (a->ctrl == NULL) return;
+    for (int i = 0; i < capacity; i++) {
+        if (a->ctrl[i] < 0) continue;
+        t->printKey(a->slots[i].key);
+        t->printValue(a->slots[i].value);
+    }
 }
 
 
 
 hashTable createHashTable(CopyFunction copyKey, FreeFunction freeKey, PrintFunction printKey,
     CopyFunction copyValue, FreeFunction freeValue, PrintFunction printValue,
-    EqualFunction equalKey, TransformIntoNumberFunction transformIntoNumber, int hashNumber) {
+    EqualFunction equalKey, HashFunction hashKey, int hashNumber) {
     /**
      * @brief Creates a hash table with specified utility functions and size.
      *
      * This function initializes a hash table, allocates memory for its structure, and
      * sets up buckets to store key-value pairs using the chaining method for collision handling.
      * It also assigns the provided utility functions for handling keys and values.
+     * Buckets are created on first use, and the table grows and shrinks by itself according to
+     * its load factors (see `setHashTableLoadFactors`).
      *
      * @param copyKey Function pointer for creating a deep copy of a key.
      * @param freeKey Function pointer for freeing the memory of a key.
@@ -119,16 +1168,89 @@ hashTable createHashTable(CopyFunction copyKey, FreeFunction freeKey, PrintFunct
      * @param freeValue Function pointer for freeing the memory of a value.
      * @param printValue Function pointer for printing a value.
      * @param equalKey Function pointer for comparing two keys for equality.
-     * @param transformIntoNumber Function pointer for transforming a key into a numeric hash value.
-     * @param hashNumber The number of buckets in the hash table.
+     * @param hashKey Function pointer for computing the seeded 64 bit hash of a key (see HashFunctions.h).
+     * @param hashNumber The initial number of buckets in the hash table. The table never
+     *                   shrinks below this number.
      *
      * @return
      * - Pointer to the newly created hash table if memory allocation is successful.
      * - `NULL` if memory allocation fails at any stage.
      */
+    return createHashTableWithEngine(copyKey, freeKey, printKey, copyValue, freeValue, printValue,
+        equalKey, hashKey, hashNumber, chainingEngine);
+}
+
+hashTable createHashTableWithEngine(CopyFunction copyKey, FreeFunction freeKey, PrintFunction printKey,
+    CopyFunction copyValue, FreeFunction freeValue, PrintFunction printValue,
+    EqualFunction equalKey, HashFunction hashKey, int hashNumber,
+    hashTableEngine engine) {
+    /**
+     * @brief Creates a hash table that stores its pairs with the given engine.
+     *
+     * - `chainingEngine` keeps a linked list of key-value pairs in every bucket.
+     * - `openAddressingEngine` keeps the keys and values in one flat slot array with a parallel
+     *   array of control bytes holding a 7 bit tag of each key's hash. Lookups compare 16 tags at
+     *   a time (with SSE2 when available) and call `equalKey` only on matching tags, which avoids
+     *   the pointer chasing of chained buckets.
+     *
+     * Both engines offer the same operations and resize themselves incrementally.
+     *
+     * @param copyKey Function pointer for creating a deep copy of a key.
+     * @param freeKey Function pointer for freeing the memory of a key.
+     * @param printKey Function pointer for printing a key.
+     * @param copyValue Function pointer for creating a deep copy of a value.
+     * @param freeValue Function pointer for freeing the memory of a value.
+     * @param printValue Function pointer for printing a value.
+     * @param equalKey Function pointer for comparing two keys for equality.
+     * @param hashKey Function pointer for computing the seeded 64 bit hash of a key (see HashFunctions.h).
+     * @param hashNumber The initial number of buckets in the hash table. The open addressing engine
+     *                   rounds it up to a power of two number of slots (at least 16).
+     * @param engine The storage engine of the table.
+     *
+     * @return
+     * - Pointer to the newly created hash table if memory allocation is successful.
+     * - `NULL` if memory allocation fails at any stage.
+     */
+    return createHashTableWithAllocator(copyKey, freeKey, printKey, copyValue, freeValue, printValue,
+        equalKey, hashKey, hashNumber, engine, NULL);
+}
+
+hashTable createHashTableWithAllocator(CopyFunction copyKey, FreeFunction freeKey, PrintFunction printKey,
+    CopyFunction copyValue, FreeFunction freeValue, PrintFunction printValue,
+    EqualFunction equalKey, HashFunction hashKey, int hashNumber,
+    hashTableEngine engine, const allocator *alloc) {
+    /**
+     * @brief Creates a hash table whose small objects come from an allocator.
+     *
+     * Works like `createHashTableWithEngine`. With the chaining engine the key-value pairs, the
+     * bucket lists and their nodes are taken from `alloc`, so that a slab pool (see
+     * `createSlabPool`) can serve them without a `malloc` call per insertion. The bucket and slot
+     * arrays, and the open addressing engine, which has no per-pair objects, still use `malloc`.
+     *
+     * @param alloc The allocator of the table (`NULL` for `malloc`). It must outlive the table.
+     *
+     * The other parameters and the return value are those of `createHashTableWithEngine`.
+     */
+    if (hashNumber <= 0) return NULL;
     hashTable t = (hashTable)malloc(sizeof(struct hashTable_s));
     if (t == NULL) return NULL;
-    t->size = hashNumber;
+    t->engine = engine;
+    t->alloc = alloc;
+    t->size = engine == openAddressingEngine ? next_power_of_two(hashNumber) : hashNumber;
+    t->table = NULL;
+    t->trees = NULL;
+    t->slots.ctrl = NULL;
+    t->slots.slots = NULL;
+    t->slots.used = 0;
+    t->newSize = 0;
+    t->newTable = NULL;
+    t->newTrees = NULL;
+    t->newSlots = t->slots;
+    t->rehashIdx = 0;
+    t->count = 0;
+    t->minSize = t->size;
+    t->maxLoadFactor = engine == openAddressingEngine ? DEFAULT_OA_MAX_LOAD_FACTOR : DEFAULT_MAX_LOAD_FACTOR;
+    t->minLoadFactor = DEFAULT_MIN_LOAD_FACTOR;
     t->copyKey = copyKey;
     t->freeKey = freeKey;
     t->printKey = printKey;
@@ -136,29 +1258,111 @@ hashTable createHashTable(CopyFunction copyKey, FreeFunction freeKey, PrintFunct
     t->freeValue = freeValue;
     t->printValue = printValue;
     t->equalKey = equalKey;
-    t->transformIntoNumber = transformIntoNumber;
+    t->compareKey = NULL;
+    t->hashKey = hashKey;
+    t->seed = DEFAULT_HASH_SEED;
+    t->pairType = NULL;
+    STAT(resetHashTableStats(t));
 
-    //alocate memory for the table, array of linked lists
-    t->table = (linked_list*)malloc(sizeof(linked_list) * t->size);
-    if (t->table == NULL) {
-        free(t);
-        return NULL;
-    }
-    // initialize linked list in every cell
-    for (int i = 0; i < t->size; i++) {
-        t->table[i] = create_kvp_list(t);
-        if (t->table[i] == NULL) {
-            for (int j = 0; j < i; j++) {
-                destroyList(t->table[j]);
-            }
-            free(t->table);
+    if (engine == openAddressingEngine) {
+        if (oa_alloc(&t->slots, t->size) == failure) {
             free(t);
             return NULL;
         }
+        return t;
+    }
+    //all the pairs of the table share one type descriptor
+    t->pairType = createKeyValueType(equalKey, printKey, printValue, freeKey, freeValue, copyKey, copyValue, alloc);
+    if (t->pairType == NULL) {
+        free(t);
+        return NULL;
+    }
+    //alocate memory for the table, array of linked lists created on first use
+    t->table = (linked_list*)calloc(t->size, sizeof(linked_list));
+    t->trees = (pair_tree*)calloc(t->size, sizeof(pair_tree));
+    if (t->table == NULL || t->trees == NULL) {
+        free(t->table);
+        free(t->trees);
+        destroyKeyValueType(t->pairType);
+        free(t);
+        return NULL;
     }
     return t;
 }
 
+status setHashTableSeed(hashTable t, uint64_t seed) {
+    /**
+     * @brief Changes the seed passed to the table's hash function.
+     *
+     * Tables start with `DEFAULT_HASH_SEED`. A random seed makes it impossible to predict
+     * which keys collide. Since every key would move, the seed can only be changed while
+     * the table is empty.
+     *
+     * @param t Pointer to the hash table.
+     * @param seed The new seed.
+     *
+     * @return
+     * - `success` if the seed is updated.
+     * - `failure` if the hash table is `NULL` or not empty.
+     */
+    if (t == NULL || t->count > 0 || is_rehashing(t)) return failure;
+    t->seed = seed;
+    return success;
+}
+
+status setHashTableKeyCompare(hashTable t, CompareFunction compareKey) {
+    /**
+     * @brief Gives the table an ordering of its keys, used to keep heavily colliding buckets balanced.
+     *
+     * A bucket of the chaining engine whose chain grows past 8 pairs is turned into a balanced
+     * search tree ordered by hash, so its searches take O(log n) steps. Keys with equal hashes
+     * (such as anagrams under a hash that adds up characters) can only be ordered with
+     * `compareKey`; without it they are still compared one by one. The ordering can only be set
+     * while the table is empty. The open addressing engine has no trees, so colliding keys keep
+     * lengthening its probes whatever the ordering; it can not be given one.
+     *
+     * @param t Pointer to the hash table.
+     * @param compareKey Function pointer returning a negative number, 0 or a positive number when
+     *                   the first key is smaller than, equal to or greater than the second. It must
+     *                   return 0 exactly for the keys `equalKey` considers equal.
+     *
+     * @return
+     * - `success` if the ordering is set.
+     * - `failure` if the hash table is `NULL`, not empty, or uses the open addressing engine.
+     */
+    if (t == NULL || t->engine == openAddressingEngine || t->count > 0 || is_rehashing(t)) return failure;
+    t->compareKey = compareKey;
+    return success;
+}
+
+status setHashTableLoadFactors(hashTable t, float maxLoadFactor, float minLoadFactor) {
+    /**
+     * @brief Configures when the hash table grows and shrinks.
+     *
+     * The table starts growing once it holds more than `maxLoadFactor` pairs per bucket and
+     * starts shrinking once it holds fewer than `minLoadFactor` pairs per bucket. A minimum of
+     * 0 disables shrinking. The maximum must be at least four times the minimum, so that a
+     * resize never leaves the table outside of the configured range, and it must stay below 1
+     * for the open addressing engine.
+     *
+     * @param t Pointer to the hash table.
+     * @param maxLoadFactor The load factor above which the table grows.
+     * @param minLoadFactor The load factor below which the table shrinks.
+     *
+     * @return
+     * - `success` if the load factors are updated.
+     * - `failure` if the hash table is `NULL` or the load factors are invalid.
+     */
+    if (t == NULL || maxLoadFactor <= 0 || minLoadFactor < 0 || minLoadFactor * 4 > maxLoadFactor) {
+        return failure;
+    }
+    if (t->engine == openAddressingEngine && maxLoadFactor >= 1) return failure;
+    t->maxLoadFactor = maxLoadFactor;
+    t->minLoadFactor = minLoadFactor;
+    check_load(t);
+    return success;
+}
+
 status destroyHashTable(hashTable t) {
     /**
      * @brief Destroys a hash table and frees all associated memory.
@@ -173,10 +1377,25 @@ status destroyHashTable(hashTable t) {
      * - `failure` if the hash table is `NULL`.
      */
     if (t == NULL) return failure;
+    if (t->engine == openAddressingEngine) {
+        oa_destroy_slots(t, &t->slots, t->size);
+        oa_destroy_slots(t, &t->newSlots, t->newSize);
+        free(t);
+        return success;
+    }
     for (int i = 0; i < t->size; i++) {
         destroyList(t->table[i]);
+        destroyPairTree(t->trees[i]);
     }
     free(t->table);
+    free(t->trees);
+    for (int i = 0; i < t->newSize; i++) {
+        destroyList(t->newTable[i]);
+        destroyPairTree(t->newTrees[i]);
+    }
+    free(t->newTable);
+    free(t->newTrees);
+    destroyKeyValueType(t->pairType);
     free(t);
     return success;
 }
@@ -187,7 +1406,7 @@ status addToHashTable(hashTable t, Element key,Element value) {
      *
      * This function inserts a key-value pair into the hash table. If a pair with the same key
      * already exists in the hash table, the insertion fails. The function calculates the
-     * appropriate bucket index using a hash function and handles collisions using the chaining method.
+     * appropriate bucket index using a hash function and handles collisions using the table's engine.
      *
      * @param hashTable Pointer to the hash table.
      * @param key The key of the key-value pair to be added.
@@ -199,19 +1418,63 @@ status addToHashTable(hashTable t, Element key,Element value) {
      *   or a pair with the same key already exists.
      */
     if (t == NULL || key == NULL || value == NULL) return failure;
-    key_value_pair kvp = createKeyValuePair(key, value, t->equalKey, t->printKey, t->printValue,
-        t->freeKey, t->freeValue, t->copyKey, t->copyValue);
-    if (kvp == NULL) return failure;
-    int idx = hash_func(t, key);
-    if (searchByKey(t->table[idx], key) != NULL) {
-        destroyKeyValuePair(kvp);
-        return failure;
-    }
-    if ( appendNode(t->table[idx], kvp)== success) {
-        return success;
-    }
-    destroyKeyValuePair(kvp);
-    return failure;
+    bool inserted;
+    Element *slot = locate_value(t, key, true, &inserted);
+    if (slot == NULL || inserted == false) return failure;
+    *slot = t->copyValue(value);
+    return success;
+}
+
+status upsertToHashTable(hashTable t, Element key, Element value) {
+    /**
+     * @brief Adds a key-value pair to the hash table, or replaces the value of an existing key.
+     *
+     * The key is hashed and searched once. It is copied only when it is inserted; for an
+     * existing key the old value is freed and replaced by a copy of the new one.
+     *
+     * @param t Pointer to the hash table.
+     * @param key The key of the key-value pair.
+     * @param value The value to store under the key.
+     *
+     * @return
+     * - `success` if the value is stored under the key.
+     * - `failure` if the hash table, key, or value is `NULL`, or memory allocation fails.
+     */
+    if (t == NULL || key == NULL || value == NULL) return failure;
+    bool inserted;
+    Element *slot = locate_value(t, key, true, &inserted);
+    if (slot == NULL) return failure;
+    Element copy = t->copyValue(value);
+    if (inserted == false && *slot != NULL) t->freeValue(*slot);
+    *slot = copy;
+    return success;
+}
+
+Element *findOrInsertInHashTable(hashTable t, Element key, bool *inserted) {
+    /**
+     * @brief Returns the address of the value stored under a key, inserting the key if it is missing.
+     *
+     * The key is hashed and searched once. When it is missing a copy of the key is inserted with
+     * a `NULL` value, and the caller must store a value through the returned pointer before the
+     * next operation on the table. The value is stored as is: the table does not copy it, but
+     * it frees it with the table's free function when the pair is removed. Values of existing
+     * keys can be read or replaced through the pointer in the same way; a replaced value is not
+     * freed by the table.
+     *
+     * The pointer stays valid until the next operation that modifies the table.
+     *
+     * @param t Pointer to the hash table.
+     * @param key The key to search for or insert.
+     * @param inserted Output parameter set to `true` if the key was inserted and `false`
+     *                 if it already existed (may be `NULL`).
+     *
+     * @return
+     * - The address of the value stored under the key.
+     * - `NULL` if the hash table or key is `NULL`, or memory allocation fails.
+     */
+    if (inserted != NULL) *inserted = false;
+    if (t == NULL || key == NULL) return NULL;
+    return locate_value(t, key, true, inserted);
 }
 
 Element lookupInHashTable(hashTable t, Element key) {
@@ -229,9 +1492,120 @@ Element lookupInHashTable(hashTable t, Element key) {
      * - `NULL` if the hash table or key is `NULL`, or if the key does not exist in the hash table.
      */
     if (key == NULL || t == NULL) return NULL;
-    int idx =  hash_func(t, key);
-    key_value_pair kvp = (key_value_pair) searchByKey(t->table[idx], key);
-    return getValue(kvp);
+    Element *value = locate_value(t, key, false, NULL);
+    if (value == NULL) return NULL;
+    return t->copyValue(*value);
+}
+
+Element borrowFromHashTable(hashTable t, Element key) {
+    /**
+     * @brief Retrieves the value associated with a given key without copying it.
+     *
+     * Unlike `lookupInHashTable`, the returned value is the one stored in the table. It still
+     * belongs to the table and must not be freed; it stays valid until its key is removed
+     * or the table is destroyed.
+     *
+     * @param t Pointer to the hash table.
+     * @param key The key to search for.
+     *
+     * @return
+     * - The value stored under the key if the key exists in the hash table.
+     * - `NULL` if the hash table or key is `NULL`, or if the key does not exist in the hash table.
+     */
+    if (key == NULL || t == NULL) return NULL;
+    Element *value = locate_value(t, key, false, NULL);
+    if (value == NULL) return NULL;
+    return *value;
+}
+
+status addManyToHashTable(hashTable t, Element *keys, Element *values, int n, status *results) {
+    /**
+     * @brief Adds many key-value pairs to the hash table.
+     *
+     * Works like calling `addToHashTable` on every pair, but the keys are hashed and their
+     * buckets prefetched in batches before any of them is inserted, so the cache misses of a
+     * batch overlap. Pairs are inserted in order, so of two pairs with the same key only the
+     * first one is added.
+     *
+     * @param t Pointer to the hash table.
+     * @param keys The keys of the pairs to be added.
+     * @param values The values of the pairs to be added.
+     * @param n The number of pairs.
+     * @param results Output array receiving the result of every insertion (may be `NULL`).
+     *
+     * @return
+     * - `success` if all the pairs are added.
+     * - `failure` if the hash table or one of the arrays is `NULL`, `n` is negative,
+     *   or at least one pair is not added (see `addToHashTable`).
+     */
+    if (t == NULL || keys == NULL || values == NULL || n < 0) return failure;
+    status res = success;
+    uint64_t hashes[HASH_BATCH];
+    while (n > 0) {
+        int len = hash_batch(t, keys, n, hashes);
+        for (int i = 0; i < len; i++) {
+            status added = failure;
+            if (keys[i] != NULL && values[i] != NULL) {
+                bool inserted;
+                Element *slot = locate_hashed(t, keys[i], hashes[i], true, &inserted);
+                if (slot != NULL && inserted) {
+                    *slot = t->copyValue(values[i]);
+                    added = success;
+                }
+            }
+            if (results != NULL) results[i] = added;
+            if (added == failure) res = failure;
+        }
+        keys += len;
+        values += len;
+        if (results != NULL) results += len;
+        n -= len;
+    }
+    return res;
+}
+
+status lookupManyInHashTable(hashTable t, Element *keys, int n, Element *values) {
+    /**
+     * @brief Retrieves the values associated with many keys in the hash table.
+     *
+     * Works like calling `lookupInHashTable` on every key, but the keys are hashed and their
+     * buckets prefetched in batches before any of them is resolved, so the cache misses of a
+     * batch overlap.
+     *
+     * @param t Pointer to the hash table.
+     * @param keys The keys to search for.
+     * @param n The number of keys.
+     * @param values Output array receiving a copy of the value of every key, or `NULL` for
+     *               keys that are `NULL` or do not exist in the hash table.
+     *
+     * @return
+     * - `success` if all the keys are searched.
+     * - `failure` if the hash table or one of the arrays is `NULL`, or `n` is negative.
+     */
+    if (t == NULL || keys == NULL || values == NULL || n < 0) return failure;
+    lookup_many(t, keys, n, values, true);
+    return success;
+}
+
+status borrowManyFromHashTable(hashTable t, Element *keys, int n, Element *values) {
+    /**
+     * @brief Retrieves the values associated with many keys without copying them.
+     *
+     * The batched counterpart of `borrowFromHashTable` (see `lookupManyInHashTable`).
+     *
+     * @param t Pointer to the hash table.
+     * @param keys The keys to search for.
+     * @param n The number of keys.
+     * @param values Output array receiving the value stored under every key, or `NULL` for
+     *               keys that are `NULL` or do not exist in the hash table.
+     *
+     * @return
+     * - `success` if all the keys are searched.
+     * - `failure` if the hash table or one of the arrays is `NULL`, or `n` is negative.
+     */
+    if (t == NULL || keys == NULL || values == NULL || n < 0) return failure;
+    lookup_many(t, keys, n, values, false);
+    return success;
 }
 
 status removeFromHashTable(hashTable t, Element key) {
@@ -249,10 +1623,23 @@ status removeFromHashTable(hashTable t, Element key) {
      * - `failure` if the hash table, key is `NULL`, or the key does not exist in the hash table.
      */
     if (t == NULL || key == NULL ) return failure;
-    int idx = hash_func(t, key);
-    Element kvp = searchByKey(t->table[idx], key);
-    if (kvp == NULL) return failure;
-    return deleteNode(t->table[idx], kvp);
+    if (is_rehashing(t)) rehash_step(t, REHASH_STEP);
+    uint64_t h = key_hash(t, key);
+    STAT(t->probes = 0);
+    if (t->engine == openAddressingEngine) {
+        oa_array *a;
+        oa_slot *slot = find_slot(t, key, h, &a);
+        STAT(record_search(t, slot != NULL));
+        if (slot == NULL) return failure;
+        t->freeKey(slot->key);
+        if (slot->value != NULL) t->freeValue(slot->value);
+        a->ctrl[slot - a->slots] = CTRL_DELETED;
+    } else {
+        if (chain_remove(t, key, h) == failure) return failure;
+    }
+    t->count--;
+    check_load(t);
+    return success;
 }
 
 status displayHashElements(hashTable t) {
@@ -269,11 +1656,96 @@ status displayHashElements(hashTable t) {
      * - `failure` if the hash table is `NULL`.
      */
     if (t == NULL) return failure;
+    if (t->engine == openAddressingEngine) {
+        oa_display_slots(t, &t->slots, t->size);
+        oa_display_slots(t, &t->newSlots, t->newSize);
+        return success;
+    }
     for (int i=0; i < t->size; i++) {
-        displayList(t->table[i]);
+        if (t->trees[i] != NULL) displayPairTree(t->trees[i]);
+        else displayList(t->table[i]);
+    }
+    for (int i=0; i < t->newSize; i++) {
+        if (t->newTrees[i] != NULL) displayPairTree(t->newTrees[i]);
+        else displayList(t->newTable[i]);
     }
     return success;
 }
 
+status getHashTableStats(hashTable t, hashTableStats *stats) {
+    /**
+     * @brief Reports the occupancy of the hash table and the cost of its searches.
+     *
+     * The counts of buckets and the longest chain are gathered by walking the whole table, so
+     * this function takes time linear in its size. The search counters are kept since the
+     * table was created or last reset (see `resetHashTableStats`), and are 0 when the table is
+     * built with `HASH_TABLE_NO_STATS`.
+     *
+     * @param t Pointer to the hash table.
+     * @param stats Output parameter receiving the statistics (see `hashTableStats`).
+     *
+     * @return
+     * - `success` if the statistics are filled in.
+     * - `failure` if the hash table or `stats` is `NULL`.
+     */
+    if (t == NULL || stats == NULL) return failure;
+    memset(stats, 0, sizeof(hashTableStats));
+    stats->count = t->count;
+    stats->buckets = t->size + t->newSize;
+    stats->loadFactor = (float) t->count / (float) stats->buckets;
+    scan_lengths(t, NULL, 0, stats);
+#ifndef HASH_TABLE_NO_STATS
+    stats->hits = t->hits;
+    stats->misses = t->misses;
+    stats->avgHitProbes = t->hits == 0 ? 0 : (float) t->hitProbes / (float) t->hits;
+    stats->avgMissProbes = t->misses == 0 ? 0 : (float) t->missProbes / (float) t->misses;
+    stats->resizes = t->resizes;
+#endif
+    return success;
+}
 
+status getHashTableHistogram(hashTable t, int *histogram, int length) {
+    /**
+     * @brief Computes how long the chains of the hash table are.
+     *
+     * For the chaining engine `histogram[i]` receives the number of buckets holding `i` pairs.
+     * For the open addressing engine it receives the number of keys stored `i` groups away from
+     * their home group, so that `histogram[0]` counts the keys found by the first group probed.
+     * The last counter also counts all longer chains.
+     *
+     * @param t Pointer to the hash table.
+     * @param histogram Output array of `length` counters.
+     * @param length The number of counters.
+     *
+     * @return
+     * - `success` if the histogram is filled in.
+     * - `failure` if the hash table or `histogram` is `NULL`, or `length` is not positive.
+     */
+    if (t == NULL || histogram == NULL || length <= 0) return failure;
+    hashTableStats stats;
+    memset(histogram, 0, length * sizeof(int));
+    scan_lengths(t, histogram, length, &stats);
+    return success;
+}
 
+status resetHashTableStats(hashTable t) {
+    /**
+     * @brief Sets the search and resize counters of the hash table back to 0.
+     *
+     * @param t Pointer to the hash table.
+     *
+     * @return
+     * - `success` if the counters are reset (or do not exist, see `HASH_TABLE_NO_STATS`).
+     * - `failure` if the hash table is `NULL`.
+     */
+    if (t == NULL) return failure;
+#ifndef HASH_TABLE_NO_STATS
+    t->probes = 0;
+    t->hits = 0;
+    t->misses = 0;
+    t->hitProbes = 0;
+    t->missProbes = 0;
+    t->resizes = 0;
+#endif
+    return success;
+}
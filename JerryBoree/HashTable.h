@@ -2,14 +2,63 @@
 #ifndef HASH_TABLE_H
 #define HASH_TABLE_H
 #include "Defs.h"
+#include "Allocator.h"
 
 typedef struct hashTable_s *hashTable;
+/**
+ * @brief How a hash table resolves collisions.
+ *
+ * `chainingEngine` keeps a list per bucket. A chain growing past 8 pairs always turns into a
+ * balanced tree ordered by the cached hashes, which bounds searches at O(log n) while the keys
+ * of the bucket have different hashes. Keys with identical hashes can only be ordered with
+ * `setHashTableKeyCompare`; without it they are still compared one by one. `openAddressingEngine`
+ * probes a flat array of slots and has no such fallback: keys whose hashes collide make its
+ * probes, and every search for them, O(n) long. It should only hold keys an attacker can choose
+ * with a hash they can not predict, that is a seeded hash (see HashFunctions.h) and a secret
+ * seed (see `setHashTableSeed`).
+ */
+typedef enum e_hashTableEngine { chainingEngine, openAddressingEngine } hashTableEngine;
 
-hashTable createHashTable(CopyFunction copyKey, FreeFunction freeKey, PrintFunction printKey, CopyFunction copyValue, FreeFunction freeValue, PrintFunction printValue, EqualFunction equalKey, TransformIntoNumberFunction transformIntoNumber, int hashNumber);
+/**
+ * @brief Health report of a hash table, filled by `getHashTableStats`.
+ *
+ * The search counters (`hits` to `resizes`) are kept by every operation. Compiling with
+ * `-DHASH_TABLE_NO_STATS` removes them from the table entirely, in which case they are
+ * reported as 0. The other fields are computed on demand and are always available.
+ */
+typedef struct s_hashTableStats {
+    int count;              /* pairs stored */
+    int buckets;            /* buckets, or slots for open addressing (of both arrays while resizing) */
+    float loadFactor;       /* pairs per bucket */
+    int usedBuckets;        /* non-empty buckets, or slots in use */
+    int tombstones;         /* deleted slots still lengthening probes (open addressing only) */
+    int longestChain;       /* pairs in the longest bucket, or groups visited by the longest probe */
+    long hits;              /* searches that found their key */
+    long misses;            /* searches that did not (including the ones before an insertion) */
+    float avgHitProbes;     /* pairs (or groups) visited per hit */
+    float avgMissProbes;    /* pairs (or groups) visited per miss */
+    long resizes;           /* resizes started */
+} hashTableStats;
+
+hashTable createHashTable(CopyFunction copyKey, FreeFunction freeKey, PrintFunction printKey, CopyFunction copyValue, FreeFunction freeValue, PrintFunction printValue, EqualFunction equalKey, HashFunction hashKey, int hashNumber);
+hashTable createHashTableWithEngine(CopyFunction copyKey, FreeFunction freeKey, PrintFunction printKey, CopyFunction copyValue, FreeFunction freeValue, PrintFunction printValue, EqualFunction equalKey, HashFunction hashKey, int hashNumber, hashTableEngine engine);
+hashTable createHashTableWithAllocator(CopyFunction copyKey, FreeFunction freeKey, PrintFunction printKey, CopyFunction copyValue, FreeFunction freeValue, PrintFunction printValue, EqualFunction equalKey, HashFunction hashKey, int hashNumber, hashTableEngine engine, const allocator *alloc);
+status setHashTableSeed(hashTable, uint64_t seed);
+status setHashTableKeyCompare(hashTable, CompareFunction compareKey);
+status setHashTableLoadFactors(hashTable, float maxLoadFactor, float minLoadFactor);
 status destroyHashTable(hashTable);
 status addToHashTable(hashTable, Element key,Element value);
+status upsertToHashTable(hashTable, Element key, Element value);
+Element *findOrInsertInHashTable(hashTable, Element key, bool *inserted);
 Element lookupInHashTable(hashTable, Element key);
+Element borrowFromHashTable(hashTable, Element key);
+status addManyToHashTable(hashTable, Element *keys, Element *values, int n, status *results);
+status lookupManyInHashTable(hashTable, Element *keys, int n, Element *values);
+status borrowManyFromHashTable(hashTable, Element *keys, int n, Element *values);
 status removeFromHashTable(hashTable, Element key);
 status displayHashElements(hashTable);
+status getHashTableStats(hashTable, hashTableStats *stats);
+status getHashTableHistogram(hashTable, int *histogram, int length);
+status resetHashTableStats(hashTable);
 
 #endif /* HASH_TABLE_H */
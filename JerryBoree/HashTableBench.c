@@ -0,0 +1,140 @@
+#include "HashTable.h"
+#include "HashFunctions.h"
+#include <time.h>
+
+/**
+ * @brief Microbenchmark of the batched operations of the hash table against single ones.
+ *
+ * For every engine, the same shuffled string keys are inserted into a table sized for them
+ * once with `addToHashTable` and once with `addManyToHashTable`, then looked up in another
+ * order with `borrowFromHashTable` and `borrowManyFromHashTable`. Keys and values are not
+ * copied, so only the work of the table is measured. Every measurement is the best of a few
+ * runs, in millions of operations per second.
+ *
+ * Usage: HashTableBench [keys] [runs]
+ */
+
+static Element same_element(Element e) {
+    return e;
+}
+
+static status keep_element(Element e) {
+    (void) e;
+    return success;
+}
+
+static status print_element(Element e) {
+    printf("%s", (char *) e);
+    return success;
+}
+
+static bool equal_strings(Element a, Element b) {
+    return strcmp((char *) a, (char *) b) == 0;
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void shuffle(Element *keys, int n, uint64_t *state) {
+    for (int i = n - 1; i > 0; i--) {
+        *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+        int j = (int) ((*state >> 33) % (uint64_t) (i + 1));
+        Element tmp = keys[i];
+        keys[i] = keys[j];
+        keys[j] = tmp;
+    }
+}
+
+static hashTable create_table(hashTableEngine engine, int n) {
+    return createHashTableWithEngine(same_element, keep_element, print_element, same_element, keep_element,
+        print_element, equal_strings, wyhashString, n, engine);
+}
+
+/**
+ * @brief Runs one measurement: fills a table, single or batched, then looks every key up.
+ *
+ * @return false if a key is not added or not found again.
+ */
+static bool run(hashTableEngine engine, Element *keys, Element *order, Element *found, int n, bool batched,
+                double *add_time, double *lookup_time) {
+    hashTable t = create_table(engine, n);
+    if (t == NULL) return false;
+    bool ok = true;
+    double start = now();
+    if (batched) {
+        ok = addManyToHashTable(t, keys, keys, n, NULL) == success;
+    } else {
+        for (int i = 0; i < n; i++) {
+            if (addToHashTable(t, keys[i], keys[i]) == failure) ok = false;
+        }
+    }
+    *add_time = now() - start;
+    start = now();
+    if (batched) {
+        borrowManyFromHashTable(t, order, n, found);
+    } else {
+        for (int i = 0; i < n; i++) found[i] = borrowFromHashTable(t, order[i]);
+    }
+    *lookup_time = now() - start;
+    for (int i = 0; i < n; i++) {
+        if (found[i] != order[i]) ok = false;
+    }
+    destroyHashTable(t);
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    int runs = argc > 2 ? atoi(argv[2]) : 3;
+    if (n <= 0 || runs <= 0) {
+        printf("usage: %s [keys] [runs]\n", argv[0]);
+        return 1;
+    }
+    char *names = (char *) malloc((size_t) n * 16);
+    Element *keys = (Element *) malloc(n * sizeof(Element));
+    Element *order = (Element *) malloc(n * sizeof(Element));
+    Element *found = (Element *) malloc(n * sizeof(Element));
+    if (names == NULL || keys == NULL || order == NULL || found == NULL) {
+        printf("out of memory\n");
+        return 1;
+    }
+    for (int i = 0; i < n; i++) {
+        keys[i] = names + (size_t) i * 16;
+        sprintf((char *) keys[i], "key-%d", i);
+    }
+    uint64_t state = 42;
+    shuffle(keys, n, &state);
+    memcpy(order, keys, n * sizeof(Element));
+    shuffle(order, n, &state);
+    hashTableEngine engines[2] = { chainingEngine, openAddressingEngine };
+    const char *engine_names[2] = { "chaining", "open addressing" };
+    bool ok = true;
+    printf("%d keys, best of %d runs, Mops/s\n", n, runs);
+    printf("%-16s %10s %10s %10s %10s\n", "engine", "add", "addMany", "borrow", "borrowMany");
+    for (int e = 0; e < 2; e++) {
+        double best[4] = { 0, 0, 0, 0 };
+        for (int r = 0; r < runs; r++) {
+            for (int batched = 0; batched < 2; batched++) {
+                double add_time, lookup_time;
+                if (!run(engines[e], keys, order, found, n, batched, &add_time, &lookup_time)) {
+                    ok = false;
+                    continue;
+                }
+                double add_rate = n / add_time / 1e6;
+                double lookup_rate = n / lookup_time / 1e6;
+                if (add_rate > best[batched]) best[batched] = add_rate;
+                if (lookup_rate > best[2 + batched]) best[2 + batched] = lookup_rate;
+            }
+        }
+        printf("%-16s %10.2f %10.2f %10.2f %10.2f\n", engine_names[e], best[0], best[1], best[2], best[3]);
+    }
+    free(names);
+    free(keys);
+    free(order);
+    free(found);
+    if (!ok) printf("a key was not added or not found again\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,233 @@
+#include "IndexedList.h"
+
+/** The highest level a node may reach; with a 1/4 promotion chance this covers any list that fits in memory. */
+#define MAX_LEVEL 16
+
+typedef struct skip_node_rec {
+    /**
+ * @brief A node of the skip list.
+ *
+ * `links[i]` is the link of the node at level `i` (level 0 joins all the nodes in order).
+ * Besides the next node, a link records its `width`: how many positions it advances. A link
+ * without a next node spans up to the position just past the last element.
+ */
+    Element data;
+    int level;
+    struct {
+        struct skip_node_rec *next;
+        int width;
+    } links[];
+} skip_node_rec, *skip_node;
+
+struct indexed_list_rec {
+    /**
+ * @brief Structure representing an indexed list.
+ *
+ * - `head`: A sentinel node at position -1 holding links at every level.
+ * - `level`: The number of levels currently in use.
+ * - `random`: The state of the generator choosing the level of new nodes.
+ */
+    skip_node head;
+    int level;
+    int listLength;
+    uint64_t random;
+    Element(*CopyFunction) (Element);
+    status(*FreeFunction) (Element);
+    status(*PrintFunction) (Element);
+    bool(*EqualFunction) (Element, Element);
+    Element (*getKeyFunction) (Element);
+};
+
+static skip_node create_skip_node(int level) {
+    return (skip_node) malloc(sizeof(skip_node_rec) + level * sizeof(((skip_node) NULL)->links[0]));
+}
+
+static int random_level(indexed_list list) {
+    /**
+ * @brief Draws the level of a new node: every level above the first is reached with chance 1/4.
+ */
+    list->random ^= list->random << 13;
+    list->random ^= list->random >> 7;
+    list->random ^= list->random << 17;
+    uint64_t bits = list->random;
+    int level = 1;
+    while (level < MAX_LEVEL && (bits & 3) == 0) {
+        level++;
+        bits >>= 2;
+    }
+    return level;
+}
+
+static skip_node find_before(indexed_list list, int index, skip_node *update, int *positions) {
+    /**
+ * @brief Walks down the levels to the node just before a position.
+ *
+ * @param index The position to stop before.
+ * @param update Output array receiving, for each level in use, the last node before the position (may be `NULL`).
+ * @param positions Output array receiving the positions of those nodes (may be `NULL`).
+ * @return The node just before the position at level 0.
+ */
+    skip_node x = list->head;
+    int pos = -1;
+    for (int lvl = list->level - 1; lvl >= 0; lvl--) {
+        while (x->links[lvl].next != NULL && pos + x->links[lvl].width < index) {
+            pos += x->links[lvl].width;
+            x = x->links[lvl].next;
+        }
+        if (update != NULL) update[lvl] = x;
+        if (positions != NULL) positions[lvl] = pos;
+    }
+    return x;
+}
+
+indexed_list createIndexedList(CopyFunction copy, EqualFunction equal, PrintFunction print, FreeFunction elem_free,
+    getKeyFunction getKey) {
+    indexed_list newList = (indexed_list) malloc(sizeof(struct indexed_list_rec));
+    if (newList == NULL)
+        return NULL;
+    newList->head = create_skip_node(MAX_LEVEL);
+    if (newList->head == NULL) {
+        free(newList);
+        return NULL;
+    }
+    newList->head->data = NULL;
+    newList->head->level = MAX_LEVEL;
+    newList->level = 1;
+    newList->head->links[0].next = NULL;
+    newList->head->links[0].width = 1;
+    newList->listLength = 0;
+    newList->random = 0x9E3779B97F4A7C15ULL;
+    newList->CopyFunction = copy;
+    newList->EqualFunction = equal;
+    newList->PrintFunction = print;
+    newList->FreeFunction = elem_free;
+    newList->getKeyFunction = getKey;
+    return newList;
+}
+
+status insertToIndexedList(indexed_list list, int index, Element elem) {
+    if (list == NULL || index < 0 || index > list->listLength) return failure;
+    int level = random_level(list);
+    skip_node added = create_skip_node(level);
+    if (added == NULL) return failure;
+    added->data = list->CopyFunction(elem);
+    added->level = level;
+    //levels coming into use start as a single link from the head to the end of the list
+    for (int lvl = list->level; lvl < level; lvl++) {
+        list->head->links[lvl].next = NULL;
+        list->head->links[lvl].width = list->listLength + 1;
+    }
+    if (level > list->level) list->level = level;
+    skip_node update[MAX_LEVEL];
+    int positions[MAX_LEVEL];
+    find_before(list, index, update, positions);
+    for (int lvl = 0; lvl < list->level; lvl++) {
+        skip_node prev = update[lvl];
+        if (lvl < level) {
+            //the link of prev is split in two around the new node, which pushes the rest one further
+            added->links[lvl].next = prev->links[lvl].next;
+            added->links[lvl].width = positions[lvl] + prev->links[lvl].width + 1 - index;
+            prev->links[lvl].next = added;
+            prev->links[lvl].width = index - positions[lvl];
+        } else {
+            prev->links[lvl].width++;
+        }
+    }
+    list->listLength++;
+    return success;
+}
+
+status appendToIndexedList(indexed_list list, Element elem) {
+    if (list == NULL) return failure;
+    return insertToIndexedList(list, list->listLength, elem);
+}
+
+Element borrowFromIndexedList(indexed_list list, int index) {
+    if (list == NULL || index < 0 || index >= list->listLength) return NULL;
+    return find_before(list, index, NULL, NULL)->links[0].next->data;
+}
+
+status removeFromIndexedList(indexed_list list, int index) {
+    if (list == NULL || index < 0 || index >= list->listLength) return failure;
+    skip_node update[MAX_LEVEL];
+    skip_node removed = find_before(list, index, update, NULL)->links[0].next;
+    for (int lvl = 0; lvl < list->level; lvl++) {
+        skip_node prev = update[lvl];
+        if (prev->links[lvl].next == removed) {
+            prev->links[lvl].width += removed->links[lvl].width - 1;
+            prev->links[lvl].next = removed->links[lvl].next;
+        } else {
+            prev->links[lvl].width--;
+        }
+    }
+    while (list->level > 1 && list->head->links[list->level - 1].next == NULL) list->level--;
+    list->listLength--;
+    list->FreeFunction(removed->data);
+    free(removed);
+    return success;
+}
+
+int indexOfKeyInIndexedList(indexed_list list, Element key) {
+    if (list == NULL) return -1;
+    int index = 0;
+    for (skip_node x = list->head->links[0].next; x != NULL; x = x->links[0].next) {
+        if (list->EqualFunction(list->getKeyFunction(x->data), key) == true) return index;
+        index++;
+    }
+    return -1;
+}
+
+int rankInIndexedList(indexed_list list, Element key, CompareFunction order) {
+    if (list == NULL || order == NULL) return -1;
+    skip_node x = list->head;
+    int pos = -1;
+    for (int lvl = list->level - 1; lvl >= 0; lvl--) {
+        while (x->links[lvl].next != NULL && order(list->getKeyFunction(x->links[lvl].next->data), key) < 0) {
+            pos += x->links[lvl].width;
+            x = x->links[lvl].next;
+        }
+    }
+    return pos + 1;
+}
+
+int getLengthIndexedList(indexed_list list) {
+    if (list == NULL) return 0;
+    return list->listLength;
+}
+
+indexed_range rangeOfIndexedList(indexed_list list, int offset, int count) {
+    indexed_range range = { NULL, 0 };
+    if (list == NULL || offset < 0 || offset >= list->listLength || count <= 0) return range;
+    range.next = find_before(list, offset, NULL, NULL)->links[0].next;
+    range.remaining = count;
+    return range;
+}
+
+Element indexedRangeNext(indexed_range *range) {
+    if (range == NULL || range->remaining == 0 || range->next == NULL) return NULL;
+    Element data = range->next->data;
+    range->next = range->next->links[0].next;
+    range->remaining--;
+    return data;
+}
+
+status displayIndexedList(indexed_list list) {
+    if (list == NULL) return failure;
+    for (skip_node x = list->head->links[0].next; x != NULL; x = x->links[0].next) {
+        list->PrintFunction(x->data);
+    }
+    return success;
+}
+
+void destroyIndexedList(indexed_list list) {
+    if (list == NULL) return;
+    skip_node x = list->head->links[0].next;
+    while (x != NULL) {
+        skip_node next = x->links[0].next;
+        list->FreeFunction(x->data);
+        free(x);
+        x = next;
+    }
+    free(list->head);
+    free(list);
+}
@@ -0,0 +1,181 @@
+#ifndef INDEXED_LIST_H
+#define INDEXED_LIST_H
+#include "Defs.h"
+#include "LinkedList.h"
+
+typedef struct indexed_list_rec* indexed_list;
+
+/**
+ * @brief A view of consecutive elements of an indexed list, kept by the caller.
+ *
+ * Members (not to be accessed directly):
+ *   - next: The node whose element is returned next.
+ *   - remaining: The number of elements still to be returned.
+ */
+typedef struct {
+    struct skip_node_rec *next;
+    int remaining;
+} indexed_range;
+
+/**
+ * @brief Creates a new indexed list with specified utility functions.
+ *
+ * An indexed list keeps its elements in order like a linked list, but is built as a skip list
+ * whose links also record how many positions they span. Reaching, inserting and removing the
+ * element at a position therefore takes O(log n) expected steps instead of a walk from the head.
+ * Positions are zero-based.
+ *
+ * @param copy Function pointer for creating a deep copy of an element.
+ * @param equal Function pointer for comparing two keys for equality.
+ * @param print Function pointer for printing an element.
+ * @param elem_free Function pointer for freeing the memory of an element.
+ * @param getKey Function pointer for extracting a key from an element.
+ *
+ * @return
+ * - Pointer to the newly created indexed list if memory allocation is successful.
+ * - `NULL` if memory allocation fails.
+ */
+indexed_list createIndexedList(CopyFunction copy, EqualFunction equal, PrintFunction print, FreeFunction elem_free,
+    getKeyFunction getKey);
+/**
+ * @brief Inserts a copy of an element at a position, moving the elements from that position on
+ * one position further.
+ *
+ * @param list Pointer to the indexed list.
+ * @param index The position of the new element, from 0 up to the length of the list (appending).
+ * @param elem The element to insert. The element is copied using the list's `CopyFunction`.
+ *
+ * @return
+ * - `success` if the element is inserted.
+ * - `failure` if the list is `NULL`, the index is out of bounds, or memory allocation fails.
+ */
+status insertToIndexedList(indexed_list list, int index, Element elem);
+/**
+ * @brief Appends a copy of an element to the end of the indexed list.
+ *
+ * @param list Pointer to the indexed list.
+ * @param elem The element to append. The element is copied using the list's `CopyFunction`.
+ *
+ * @return
+ * - `success` if the element is appended.
+ * - `failure` if the list is `NULL` or memory allocation fails.
+ */
+status appendToIndexedList(indexed_list list, Element elem);
+/**
+ * @brief Retrieves the element at a position without copying it.
+ *
+ * @param list Pointer to the indexed list.
+ * @param index The zero-based position of the element.
+ *
+ * @return
+ * - The element stored at the position (still owned by the list).
+ * - `NULL` if the list is `NULL` or the index is out of bounds.
+ */
+Element borrowFromIndexedList(indexed_list list, int index);
+/**
+ * @brief Removes the element at a position and frees it using the list's `FreeFunction`.
+ *
+ * @param list Pointer to the indexed list.
+ * @param index The zero-based position of the element.
+ *
+ * @return
+ * - `success` if the element is removed.
+ * - `failure` if the list is `NULL` or the index is out of bounds.
+ */
+status removeFromIndexedList(indexed_list list, int index);
+/**
+ * @brief Finds the position of the first element whose key equals a given key.
+ *
+ * Keys are not ordered, so this walks the list in O(n).
+ *
+ * @param list Pointer to the indexed list.
+ * @param key The key to search for, compared using the list's `EqualFunction` and `getKeyFunction`.
+ *
+ * @return
+ * - The zero-based position of the element.
+ * - `-1` if the list is `NULL` or no element has the key.
+ */
+int indexOfKeyInIndexedList(indexed_list list, Element key);
+/**
+ * @brief Finds the position a key has, or would take, in a list kept sorted by its keys.
+ *
+ * The levels are walked down as for a position, comparing keys instead of counting, so this takes
+ * O(log n) expected steps. It is only meaningful while the elements are in increasing order of
+ * their keys, e.g. when every element was inserted at the position this returned for its key.
+ *
+ * @param list Pointer to the indexed list.
+ * @param key The key to search for, extracted from the elements with the list's `getKeyFunction`.
+ * @param order Function pointer ordering two keys: negative, 0 or positive if the first key is
+ *        smaller than, equal to or greater than the second.
+ *
+ * @return
+ * - The number of elements whose key is smaller than `key`: the position of the first element
+ *   with the key if there is one.
+ * - `-1` if the list or the order is `NULL`.
+ */
+int rankInIndexedList(indexed_list list, Element key, CompareFunction order);
+/**
+ * @brief Retrieves the number of elements in the indexed list.
+ *
+ * @param list Pointer to the indexed list.
+ *
+ * @return
+ * - The number of elements in the list.
+ * - `0` if the list is `NULL`.
+ */
+int getLengthIndexedList(indexed_list list);
+/**
+ * @brief Creates a view of up to `count` elements starting at position `offset`.
+ *
+ * Reaching the first element takes O(log n) steps and every further element one step, so a page
+ * of a long list costs its own size rather than a walk from the head. The list must not be changed
+ * while the view is in use.
+ *
+ * @param list Pointer to the indexed list.
+ * @param offset The zero-based position of the first element of the view.
+ * @param count The largest number of elements in the view. The view ends early at the end of the list.
+ *
+ * @return The view, to be read with `indexedRangeNext`. It is empty if the list is `NULL`, the
+ * offset is out of bounds or the count is not positive.
+ */
+indexed_range rangeOfIndexedList(indexed_list list, int offset, int count);
+/**
+ * @brief Returns the next element of a view without copying it.
+ *
+ * @param range Pointer to the view.
+ *
+ * @return
+ * - The next element of the view.
+ * - `NULL` once all the elements of the view were returned.
+ */
+Element indexedRangeNext(indexed_range *range);
+/**
+ * @brief Displays all elements of the indexed list in order, using the list's `PrintFunction`.
+ *
+ * @param list Pointer to the indexed list.
+ *
+ * @return
+ * - `success` if the list is displayed.
+ * - `failure` if the list is `NULL`.
+ */
+status displayIndexedList(indexed_list list);
+/**
+ * @brief Frees an indexed list together with all the elements it holds.
+ *
+ * @param list Pointer to the indexed list. The function performs no operation if it is `NULL`.
+ *
+ * @return Void.
+ */
+void destroyIndexedList(indexed_list list);
+/**
+ * @brief Macro for iterating through the elements of a range of an indexed list.
+ *
+ * @param e The variable to hold the current element during the iteration.
+ * @param l The indexed list to iterate over.
+ * @param offset The zero-based position of the first element.
+ * @param count The largest number of elements to visit.
+ */
+#define range_forEach(e, l, offset, count) \
+    for (indexed_range range_it_ = rangeOfIndexedList(l, offset, count); ((e) = indexedRangeNext(&range_it_)) != NULL; )
+
+#endif
@@ -0,0 +1,176 @@
+#include "IndexedList.h"
+
+/**
+ * @brief Behaviour check of the indexed list against a plain array.
+ *
+ * Random insertions, appends and removals at random positions are applied to an indexed list
+ * and to an array holding the same elements, and after every step the list is compared with the
+ * array: its length, the element at random positions, a random page read with `range_forEach`,
+ * and the position of a key found with `indexOfKeyInIndexedList`. A second list is kept sorted
+ * the way the daycare keeps its Jerries by ID: every key is inserted at the rank
+ * `rankInIndexedList` gives it and removed from the rank of its key, and the result is checked
+ * against the sorted array, page by page.
+ *
+ * Usage: IndexedListCheck [steps] [seed]
+ */
+
+#define MAX_SIZE 4096
+
+static Element same_element(Element e) {
+    return e;
+}
+
+static status keep_element(Element e) {
+    (void) e;
+    return success;
+}
+
+static status print_element(Element e) {
+    printf("%ld ", (long) (intptr_t) e);
+    return success;
+}
+
+static bool equal_elements(Element a, Element b) {
+    return a == b;
+}
+
+static int order_elements(Element a, Element b) {
+    intptr_t x = (intptr_t) a, y = (intptr_t) b;
+    return x < y ? -1 : x > y;
+}
+
+static uint64_t next_random(uint64_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static int pick(uint64_t *state, int bound) {
+    return (int) (next_random(state) % (uint64_t) bound);
+}
+
+static indexed_list create_list(void) {
+    return createIndexedList(same_element, equal_elements, print_element, keep_element, same_element);
+}
+
+/**
+ * @brief Compares the list with the array at a few random positions and on a random page.
+ *
+ * @return The number of differences found.
+ */
+static long compare(indexed_list list, intptr_t *model, int size, uint64_t *state) {
+    long wrong = 0;
+    if (getLengthIndexedList(list) != size) return 1;
+    for (int i = 0; i < 4 && size > 0; i++) {
+        int index = pick(state, size);
+        if (borrowFromIndexedList(list, index) != (Element) model[index]) wrong++;
+    }
+    if (borrowFromIndexedList(list, size) != NULL || borrowFromIndexedList(list, -1) != NULL) wrong++;
+    int page_size = 1 + pick(state, 16);
+    int offset = pick(state, size + 2);
+    int seen = 0;
+    Element elem;
+    range_forEach(elem, list, offset, page_size) {
+        if (offset + seen >= size || elem != (Element) model[offset + seen]) wrong++;
+        seen++;
+    }
+    int expected = offset >= size ? 0 : (size - offset < page_size ? size - offset : page_size);
+    if (seen != expected) wrong++;
+    return wrong;
+}
+
+/**
+ * @brief Applies random operations by position to a list and checks it after every one.
+ */
+static long check_positions(int steps, uint64_t *state) {
+    static intptr_t model[MAX_SIZE];
+    indexed_list list = create_list();
+    if (list == NULL) return 1;
+    int size = 0;
+    intptr_t next_key = 1;
+    long wrong = 0;
+    for (int step = 0; step < steps; step++) {
+        int op = pick(state, 10);
+        if (op < 5 && size < MAX_SIZE) {
+            int index = op == 0 ? size : pick(state, size + 1);
+            intptr_t key = next_key++;
+            status added = op == 0 ? appendToIndexedList(list, (Element) key) : insertToIndexedList(list, index, (Element) key);
+            if (added == failure) wrong++;
+            memmove(model + index + 1, model + index, (size - index) * sizeof(intptr_t));
+            model[index] = key;
+            size++;
+        } else if (op < 9 && size > 0) {
+            int index = pick(state, size);
+            if (removeFromIndexedList(list, index) == failure) wrong++;
+            memmove(model + index, model + index + 1, (size - index - 1) * sizeof(intptr_t));
+            size--;
+        } else if (size > 0) {
+            int index = pick(state, size);
+            if (indexOfKeyInIndexedList(list, (Element) model[index]) != index) wrong++;
+        }
+        if (insertToIndexedList(list, size + 1, (Element) next_key) == success || removeFromIndexedList(list, size) == success) wrong++;
+        wrong += compare(list, model, size, state);
+    }
+    destroyIndexedList(list);
+    return wrong;
+}
+
+/**
+ * @brief Keeps a list sorted by inserting and removing at ranks, and checks it after every operation.
+ */
+static long check_ranks(int steps, uint64_t *state) {
+    static intptr_t model[MAX_SIZE];
+    indexed_list list = create_list();
+    if (list == NULL) return 1;
+    int size = 0;
+    long wrong = 0;
+    for (int step = 0; step < steps; step++) {
+        //the keys are drawn from a small range, so that searches often hit keys already in the list
+        intptr_t key = 1 + pick(state, 2 * MAX_SIZE);
+        int rank = 0;
+        while (rank < size && model[rank] < key) rank++;
+        if (rankInIndexedList(list, (Element) key, order_elements) != rank) wrong++;
+        bool present = rank < size && model[rank] == key;
+        if (present && pick(state, 2) == 0) {
+            if (removeFromIndexedList(list, rankInIndexedList(list, (Element) key, order_elements)) == failure) wrong++;
+            memmove(model + rank, model + rank + 1, (size - rank - 1) * sizeof(intptr_t));
+            size--;
+        } else if (!present && size < MAX_SIZE && pick(state, 3) != 0) {
+            if (insertToIndexedList(list, rankInIndexedList(list, (Element) key, order_elements), (Element) key) == failure) wrong++;
+            memmove(model + rank + 1, model + rank, (size - rank) * sizeof(intptr_t));
+            model[rank] = key;
+            size++;
+        } else if (size > 0) {
+            //every page of the list, read one after another, must give back the sorted keys
+            int page_size = 1 + pick(state, 64);
+            int index = 0;
+            for (int offset = 0; offset < size; offset += page_size) {
+                Element elem;
+                range_forEach(elem, list, offset, page_size) {
+                    if (index >= size || elem != (Element) model[index]) wrong++;
+                    index++;
+                }
+            }
+            if (index != size) wrong++;
+        }
+        wrong += compare(list, model, size, state);
+    }
+    if (rankInIndexedList(NULL, (Element) 1, order_elements) != -1 || rankInIndexedList(list, (Element) 1, NULL) != -1) wrong++;
+    destroyIndexedList(list);
+    return wrong;
+}
+
+int main(int argc, char **argv) {
+    int steps = argc > 1 ? atoi(argv[1]) : 20000;
+    uint64_t seed = argc > 2 ? strtoull(argv[2], NULL, 10) : 42;
+    if (steps <= 0 || seed == 0) {
+        printf("usage: %s [steps] [seed (not 0)]\n", argv[0]);
+        return 1;
+    }
+    uint64_t state = seed;
+    long by_position = check_positions(steps, &state);
+    long by_rank = check_ranks(steps, &state);
+    printf("%d steps: %ld differences by position, %ld differences by rank\n", steps, by_position, by_rank);
+    return by_position == 0 && by_rank == 0 ? 0 : 1;
+}
@@ -3,28 +3,530 @@
 //
 
 #include "Jerry.h"
+#include "StringPool.h"
+#include "HappinessKernel.h"
 
 extern bool memoryProb;
 
-Origin *createOrigin(char dim[], Planet* planet);
+/** The pool interning the names of planets, dimensions and physical characteristics, created on first use. */
+static string_pool names = NULL;
+
+char *internName(char name[]) {
+    if (names == NULL) names = createStringPool();
+    char *canonical = internString(names, name);
+    if (canonical == NULL) memoryProb = true;
+    return canonical;
+}
+
+char *findName(char name[]) {
+    return findInternedString(names, name);
+}
+
+void releaseNames(void) {
+    destroyStringPool(names);
+    names = NULL;
+}
+
+/** The number of rows of a new store; the columns double whenever they are full. */
+#define INITIAL_ROWS 16
+/** The number of happiness levels an activity can leave, from 0 to 100. */
+#define LEVELS 101
+/** The buckets of the saddest-Jerry queue: one per level from 0 to 100, then the levels below 0 and those above 100. */
+#define BELOW LEVELS
+#define ABOVE (LEVELS + 1)
+#define BUCKETS (LEVELS + 2)
+
+/**
+ * @brief A list of rows of a store, linked through two of its columns (-1 ends the list).
+ */
+typedef struct {
+    int head;
+    int tail;
+} row_list;
+
+/**
+ * @brief The Jerries of a store that joined it between two points in time, with their pending activities.
+ *
+ * - `pending` / `first` / `composed`: The activities not applied to the happiness column of these
+ *   Jerries yet. The first one brings any level into [0, 100], and `composed` maps each of those
+ *   levels to the level left by all the others, so the actual level of a row is
+ *   `composed[first(happiness)]`.
+ * - `buckets`: Every row of the cohort is in the bucket of the level in its happiness column, each
+ *   bucket in arrival order. Activities only change `composed`, so the rows stay put until the
+ *   cohort is settled, when the buckets are rebuilt from `arrivals`, its rows in arrival order.
+ */
+typedef struct {
+    int size;
+    bool pending;
+    int first[3];
+    int composed[LEVELS];
+    row_list buckets[BUCKETS];
+    row_list arrivals;
+} cohort;
+
+/**
+ * @brief The column of values of one physical characteristic, a row per Jerry of the store.
+ *
+ * Only the rows of the Jerries having the characteristic hold a value.
+ */
+typedef struct {
+    char *name;
+    float *values;
+} phys_column;
+
+struct jerry_store_rec {
+    /**
+ * @brief Structure representing a columnar store of Jerries.
+ *
+ * - `jerries`: The Jerry of every row, i.e. the view of every ordinal.
+ * - `happiness` / `planet` / `dim`: The happiness level, planet and interned dimension of every row.
+ * - `arrival`: The order in which the Jerries of the rows joined the store, breaking ties between them.
+ * - `columns`: The columns of the physical characteristics, a Jerry's `phys` holding positions in it.
+ *   They are few, so a column is found by comparing interned names.
+ * - `cohorts`: The rows grouped by when they joined the store, the oldest cohort first, and
+ *   `cohort_of` the cohort of every row. A Jerry joining after an activity starts a new cohort, so
+ *   it never has to wait for the activities before it to be applied to the others. Every cohort is
+ *   more than twice as big as the next one; a cohort growing past half of the one before is merged
+ *   into it, after both are settled, so there are O(log n) cohorts. The buckets and arrival lists
+ *   of the cohorts are linked through `bucket_prev` / `bucket_next` and `arrival_prev` / `arrival_next`.
+ */
+    Jerry **jerries;
+    int *happiness;
+    Planet **planet;
+    char **dim;
+    unsigned long *arrival;
+    unsigned long next_arrival;
+    int size;
+    int capacity;
+    phys_column *columns;
+    int column_num;
+    cohort *cohorts;
+    int cohort_num;
+    int cohort_capacity;
+    int *cohort_of;
+    int *bucket_prev;
+    int *bucket_next;
+    int *arrival_prev;
+    int *arrival_next;
+};
+
+static int bucket_of(int level) {
+    if (level < 0) return BELOW;
+    if (level >= LEVELS) return ABOVE;
+    return level;
+}
+
+static void append_row(row_list *list, int *prev, int *next, int row) {
+    prev[row] = list->tail;
+    next[row] = -1;
+    if (list->tail != -1) next[list->tail] = row;
+    else list->head = row;
+    list->tail = row;
+}
+
+static void unlink_row(row_list *list, int *prev, int *next, int row) {
+    if (prev[row] != -1) next[prev[row]] = next[row];
+    else list->head = next[row];
+    if (next[row] != -1) prev[next[row]] = prev[row];
+    else list->tail = prev[row];
+}
+
+static void relink_row(row_list *list, int *prev, int *next, int from, int to) {
+    /**
+ * @brief Moves a row of a list to another (unused) row number, keeping its place in the list.
+ */
+    prev[to] = prev[from];
+    next[to] = next[from];
+    if (prev[to] != -1) next[prev[to]] = to;
+    else list->head = to;
+    if (next[to] != -1) prev[next[to]] = to;
+    else list->tail = to;
+}
+
+static void concat_rows(row_list *list, row_list *after, int *prev, int *next) {
+    if (after->head == -1) return;
+    if (list->tail == -1) {
+        *list = *after;
+        return;
+    }
+    next[list->tail] = after->head;
+    prev[after->head] = list->tail;
+    list->tail = after->tail;
+}
+
+static int resolve_level(cohort *c, int level) {
+    /**
+ * @brief Applies the pending activities of a cohort to a level of its happiness column.
+ */
+    if (!c->pending) return level;
+    runActivity(&level, 1, c->first[0], c->first[1], c->first[2]);
+    return c->composed[level];
+}
+
+/**
+ * @brief Brings the happiness column of the rows of a cohort up to date with its pending activities.
+ *
+ * Every level is mapped through the first activity and the composition of the others, so the cost
+ * is O(rows of the cohort) however many activities were pending. The rows then sit in the buckets
+ * of their new levels.
+ */
+static void settle_cohort(jerry_store store, cohort *c) {
+    if (!c->pending) return;
+    for (int b = 0; b < BUCKETS; b++) {
+        c->buckets[b].head = c->buckets[b].tail = -1;
+    }
+    for (int row = c->arrivals.head; row != -1; row = store->arrival_next[row]) {
+        store->happiness[row] = resolve_level(c, store->happiness[row]);
+        append_row(&c->buckets[bucket_of(store->happiness[row])], store->bucket_prev, store->bucket_next, row);
+    }
+    c->pending = false;
+}
+
+/**
+ * @brief Starts a new, empty cohort after the others.
+ *
+ * @return false if memory allocation fails.
+ */
+static bool open_cohort(jerry_store store) {
+    if (store->cohort_num == store->cohort_capacity) {
+        int capacity = store->cohort_capacity == 0 ? 4 : store->cohort_capacity * 2;
+        cohort *cohorts = (cohort *) realloc(store->cohorts, capacity * sizeof(cohort));
+        if (cohorts == NULL) return false;
+        store->cohorts = cohorts;
+        store->cohort_capacity = capacity;
+    }
+    cohort *c = &store->cohorts[store->cohort_num++];
+    c->size = 0;
+    c->pending = false;
+    for (int b = 0; b < BUCKETS; b++) {
+        c->buckets[b].head = c->buckets[b].tail = -1;
+    }
+    c->arrivals.head = c->arrivals.tail = -1;
+    return true;
+}
+
+/**
+ * @brief Merges the last cohort into the one before it, once both are settled.
+ *
+ * All the rows of the last cohort joined after those of the one before, so every bucket and the
+ * arrival list of the merged cohort are the lists of the two put end to end.
+ */
+static void merge_last_cohorts(jerry_store store) {
+    int into = store->cohort_num - 2;
+    cohort *older = &store->cohorts[into];
+    cohort *newer = &store->cohorts[into + 1];
+    settle_cohort(store, older);
+    settle_cohort(store, newer);
+    for (int row = newer->arrivals.head; row != -1; row = store->arrival_next[row]) {
+        store->cohort_of[row] = into;
+    }
+    for (int b = 0; b < BUCKETS; b++) {
+        concat_rows(&older->buckets[b], &newer->buckets[b], store->bucket_prev, store->bucket_next);
+    }
+    concat_rows(&older->arrivals, &newer->arrivals, store->arrival_prev, store->arrival_next);
+    older->size += newer->size;
+    store->cohort_num--;
+}
+
+jerry_store createJerryStore(void) {
+    jerry_store store = (jerry_store) calloc(1, sizeof(struct jerry_store_rec));
+    if (store == NULL) {
+        memoryProb = true;
+        return NULL;
+    }
+    store->jerries = (Jerry **) malloc(INITIAL_ROWS * sizeof(Jerry *));
+    store->happiness = (int *) malloc(INITIAL_ROWS * sizeof(int));
+    store->planet = (Planet **) malloc(INITIAL_ROWS * sizeof(Planet *));
+    store->dim = (char **) malloc(INITIAL_ROWS * sizeof(char *));
+    store->arrival = (unsigned long *) malloc(INITIAL_ROWS * sizeof(unsigned long));
+    store->bucket_prev = (int *) malloc(INITIAL_ROWS * sizeof(int));
+    store->bucket_next = (int *) malloc(INITIAL_ROWS * sizeof(int));
+    store->arrival_prev = (int *) malloc(INITIAL_ROWS * sizeof(int));
+    store->arrival_next = (int *) malloc(INITIAL_ROWS * sizeof(int));
+    store->cohort_of = (int *) malloc(INITIAL_ROWS * sizeof(int));
+    if (store->jerries == NULL || store->happiness == NULL || store->planet == NULL || store->dim == NULL ||
+        store->arrival == NULL || store->bucket_prev == NULL || store->bucket_next == NULL ||
+        store->arrival_prev == NULL || store->arrival_next == NULL || store->cohort_of == NULL) {
+        destroyJerryStore(store);
+        memoryProb = true;
+        return NULL;
+    }
+    store->capacity = INITIAL_ROWS;
+    return store;
+}
+
+/**
+ * @brief Doubles the rows of every column of a store.
+ *
+ * A column that grew stays valid when a later one fails, so the store is only marked bigger
+ * once all of them grew.
+ */
+static bool grow_store(jerry_store store) {
+    int capacity = store->capacity * 2;
+    Jerry **jerries = (Jerry **) realloc(store->jerries, capacity * sizeof(Jerry *));
+    if (jerries == NULL) return false;
+    store->jerries = jerries;
+    int *happiness = (int *) realloc(store->happiness, capacity * sizeof(int));
+    if (happiness == NULL) return false;
+    store->happiness = happiness;
+    Planet **planet = (Planet **) realloc(store->planet, capacity * sizeof(Planet *));
+    if (planet == NULL) return false;
+    store->planet = planet;
+    char **dim = (char **) realloc(store->dim, capacity * sizeof(char *));
+    if (dim == NULL) return false;
+    store->dim = dim;
+    unsigned long *arrival = (unsigned long *) realloc(store->arrival, capacity * sizeof(unsigned long));
+    if (arrival == NULL) return false;
+    store->arrival = arrival;
+    int **links[5] = { &store->bucket_prev, &store->bucket_next, &store->arrival_prev, &store->arrival_next,
+        &store->cohort_of };
+    for (int l = 0; l < 5; l++) {
+        int *grown = (int *) realloc(*links[l], capacity * sizeof(int));
+        if (grown == NULL) return false;
+        *links[l] = grown;
+    }
+    for (int c = 0; c < store->column_num; c++) {
+        float *values = (float *) realloc(store->columns[c].values, capacity * sizeof(float));
+        if (values == NULL) return false;
+        store->columns[c].values = values;
+    }
+    store->capacity = capacity;
+    return true;
+}
+
+/**
+ * @brief Retrieves the position of the column of a characteristic, creating the column if needed.
+ *
+ * @return The position of the column, or -1 if memory allocation fails.
+ */
+static int find_column(jerry_store store, char *name) {
+    for (int c = 0; c < store->column_num; c++) {
+        if (store->columns[c].name == name) return c;
+    }
+    phys_column *columns = (phys_column *) realloc(store->columns, (store->column_num + 1) * sizeof(phys_column));
+    if (columns == NULL) return -1;
+    store->columns = columns;
+    float *values = (float *) malloc(store->capacity * sizeof(float));
+    if (values == NULL) return -1;
+    columns[store->column_num].name = name;
+    columns[store->column_num].values = values;
+    return store->column_num++;
+}
+
+int getJerryStoreSize(jerry_store store) {
+    if (store == NULL) return 0;
+    return store->size;
+}
+
+Jerry *getJerryByOrdinal(jerry_store store, int ordinal) {
+    if (store == NULL || ordinal < 0 || ordinal >= store->size) return NULL;
+    return store->jerries[ordinal];
+}
+
+void applyActivity(jerry_store store, int min, int subtraction, int add) {
+    if (store == NULL) return;
+    for (int i = 0; i < store->cohort_num; i++) {
+        cohort *c = &store->cohorts[i];
+        if (c->size == 0) {
+            c->pending = false;
+        } else if (!c->pending) {
+            c->pending = true;
+            c->first[0] = min;
+            c->first[1] = subtraction;
+            c->first[2] = add;
+            for (int level = 0; level < LEVELS; level++) c->composed[level] = level;
+        } else {
+            //running the activity over every level the others can leave composes it after them
+            runActivity(c->composed, LEVELS, min, subtraction, add);
+        }
+    }
+}
+
+/**
+ * @brief A row of a bucket below 0 or above 100, with its actual level.
+ */
+typedef struct {
+    int level;
+    unsigned long arrival;
+    int row;
+} outer_row;
+
+static bool outer_before(const outer_row *first, const outer_row *second) {
+    if (first->level != second->level) return first->level < second->level;
+    return first->arrival < second->arrival;
+}
+
+static void sift_outer_row(outer_row *heap, int num, int i) {
+    /**
+ * @brief Moves a row of a binary min-heap of outer rows down to its place.
+ */
+    while (true) {
+        int least = i;
+        int left = 2 * i + 1;
+        if (left < num && outer_before(&heap[left], &heap[least])) least = left;
+        if (left + 1 < num && outer_before(&heap[left + 1], &heap[least])) least = left + 1;
+        if (least == i) return;
+        outer_row tmp = heap[i];
+        heap[i] = heap[least];
+        heap[least] = tmp;
+        i = least;
+    }
+}
+
+static int pop_outer_row(outer_row *heap, int *num) {
+    int row = heap[0].row;
+    heap[0] = heap[--*num];
+    sift_outer_row(heap, *num, 0);
+    return row;
+}
+
+int findSaddestJerries(jerry_store store, Jerry **saddest, int count) {
+    if (store == NULL || saddest == NULL || store->size == 0 || count <= 0) return 0;
+    int outer_num = 0;
+    for (int i = 0; i < 2 * store->cohort_num; i++) {
+        cohort *c = &store->cohorts[i / 2];
+        for (int row = c->buckets[i % 2 ? ABOVE : BELOW].head; row != -1; row = store->bucket_next[row]) outer_num++;
+    }
+    int source_num = store->cohort_num * LEVELS;
+    int *source = (int *) malloc(source_num * sizeof(int));
+    int *source_next = (int *) malloc(source_num * sizeof(int));
+    outer_row *outer = (outer_row *) malloc((outer_num > 0 ? outer_num : 1) * sizeof(outer_row));
+    if (source == NULL || source_next == NULL || outer == NULL) {
+        free(source);
+        free(source_next);
+        free(outer);
+        memoryProb = true;
+        return 0;
+    }
+    //with activities pending, all the rows of a level bucket of a cohort still share one actual level,
+    //so the buckets are grouped by that level, and only the buckets of one level are merged
+    int level_sources[LEVELS];
+    for (int level = 0; level < LEVELS; level++) level_sources[level] = -1;
+    for (int s = 0; s < source_num; s++) {
+        cohort *c = &store->cohorts[s / LEVELS];
+        source[s] = c->buckets[s % LEVELS].head;
+        if (source[s] == -1) continue;
+        int level = resolve_level(c, s % LEVELS);
+        source_next[s] = level_sources[level];
+        level_sources[level] = s;
+    }
+    //the rows outside [0, 100] each resolve on their own, so they go into a heap built once in O(outer)
+    outer_num = 0;
+    for (int i = 0; i < 2 * store->cohort_num; i++) {
+        cohort *c = &store->cohorts[i / 2];
+        for (int row = c->buckets[i % 2 ? ABOVE : BELOW].head; row != -1; row = store->bucket_next[row]) {
+            outer[outer_num].level = resolve_level(c, store->happiness[row]);
+            outer[outer_num].arrival = store->arrival[row];
+            outer[outer_num++].row = row;
+        }
+    }
+    for (int i = outer_num / 2 - 1; i >= 0; i--) sift_outer_row(outer, outer_num, i);
+    int found = 0;
+    while (found < count && outer_num > 0 && outer[0].level < 0) {
+        saddest[found++] = store->jerries[pop_outer_row(outer, &outer_num)];
+    }
+    for (int level = 0; level < LEVELS && found < count; level++) {
+        while (found < count) {
+            int best = -1;
+            for (int s = level_sources[level]; s != -1; s = source_next[s]) {
+                if (source[s] != -1 && (best == -1 || store->arrival[source[s]] < store->arrival[source[best]])) best = s;
+            }
+            if (outer_num > 0 && outer[0].level == level &&
+                (best == -1 || outer[0].arrival < store->arrival[source[best]])) {
+                saddest[found++] = store->jerries[pop_outer_row(outer, &outer_num)];
+            } else if (best != -1) {
+                saddest[found++] = store->jerries[source[best]];
+                source[best] = store->bucket_next[source[best]];
+            } else {
+                break;
+            }
+        }
+    }
+    while (found < count && outer_num > 0) {
+        saddest[found++] = store->jerries[pop_outer_row(outer, &outer_num)];
+    }
+    free(source);
+    free(source_next);
+    free(outer);
+    return found;
+}
+
+Jerry *findSaddestJerry(jerry_store store) {
+    Jerry *saddest = NULL;
+    findSaddestJerries(store, &saddest, 1);
+    return saddest;
+}
+
+void destroyJerryStore(jerry_store store) {
+    if (store == NULL) return;
+    for (int c = 0; c < store->column_num; c++) {
+        free(store->columns[c].values);
+    }
+    free(store->columns);
+    free(store->jerries);
+    free(store->happiness);
+    free(store->planet);
+    free(store->dim);
+    free(store->arrival);
+    free(store->bucket_prev);
+    free(store->bucket_next);
+    free(store->arrival_prev);
+    free(store->arrival_next);
+    free(store->cohort_of);
+    free(store->cohorts);
+    free(store);
+}
+
+int getHappiness(Jerry *j) {
+    jerry_store store = j->store;
+    return resolve_level(&store->cohorts[store->cohort_of[j->ordinal]], store->happiness[j->ordinal]);
+}
+
+Planet *getPlanet(Jerry *j) {
+    return j->store->planet[j->ordinal];
+}
+
+char *getDimension(Jerry *j) {
+    return j->store->dim[j->ordinal];
+}
+
+char *getPhysName(Jerry *j, int i) {
+    return j->store->columns[j->phys[i]].name;
+}
+
+float getPhysVal(Jerry *j, int i) {
+    return j->store->columns[j->phys[i]].values[j->ordinal];
+}
 
 /**
  * @function createJerry
- * @brief Creates and initializes a new Jerry object with the given ID, happiness level, and origin.
+ * @brief Creates and initializes a new Jerry object in the next row of a store.
  *
- * This function allocates memory for a new Jerry structure, assigns the provided ID, happiness level,
- * and origin, and initializes the physical characteristics array to NULL.
+ * This function allocates memory for a new Jerry structure, assigns the provided ID, gives it the
+ * next ordinal of the store, writes the happiness level, planet and dimension into the row, and
+ * initializes the physical characteristics array to NULL.
  *
+ * @param store The store holding the Jerry.
  * @param id A string representing the Jerry's unique identifier.
  * @param happiness The happiness level of the Jerry.
- * @param origin A pointer to an Origin structure representing the Jerry's origin.
+ * @param planet A pointer to the planet the Jerry comes from.
+ * @param dim The interned dimension the Jerry comes from.
  *
  * @return Jerry* A pointer to the newly created Jerry object, or NULL if memory allocation fails.
  *
  * @note This function may set a global flag `memoryProb` to `true` if memory allocation fails.
  */
-Jerry *createJerry(char id[], int happiness, Origin *origin) {
-    if (id == NULL || origin == NULL) {
+Jerry *createJerry(jerry_store store, char id[], int happiness, Planet *planet, char *dim) {
+    if (store == NULL || id == NULL || planet == NULL || dim == NULL) {
+        memoryProb = true;
+        return NULL;
+    }
+    if (store->size == store->capacity && !grow_store(store)) {
+        memoryProb = true;
+        return NULL;
+    }
+    //the pending activities took place before the Jerry arrived, so it joins a cohort without any
+    if ((store->cohort_num == 0 || store->cohorts[store->cohort_num - 1].pending) && !open_cohort(store)) {
         memoryProb = true;
         return NULL;
     }
@@ -35,28 +537,43 @@ Jerry *createJerry(char id[], int happiness, Origin *origin) {
     }
     j->id = (char *)malloc(strlen(id) + 1);
     if (j->id == NULL) {
-        delJerry(&j);
+        free(j);
         memoryProb = true;
         return NULL;
     }
     strcpy(j->id, id);
-    j->happines_level = happiness;
-    j->origin = origin;
+    j->store = store;
+    j->ordinal = store->size++;
     j->phys_num = 0;
-    j->phys_char = NULL;
+    j->phys = NULL;
+    initListLink(&j->daycareLink);
+    store->jerries[j->ordinal] = j;
+    store->happiness[j->ordinal] = happiness;
+    store->planet[j->ordinal] = planet;
+    store->dim[j->ordinal] = dim;
+    store->arrival[j->ordinal] = store->next_arrival++;
+    cohort *c = &store->cohorts[store->cohort_num - 1];
+    store->cohort_of[j->ordinal] = store->cohort_num - 1;
+    append_row(&c->buckets[bucket_of(happiness)], store->bucket_prev, store->bucket_next, j->ordinal);
+    append_row(&c->arrivals, store->arrival_prev, store->arrival_next, j->ordinal);
+    c->size++;
+    while (store->cohort_num > 1 &&
+           store->cohorts[store->cohort_num - 2].size <= 2 * store->cohorts[store->cohort_num - 1].size) {
+        merge_last_cohorts(store);
+    }
     return j;
     }
 
-Jerry *createJerry_with_planet(char id[], int happiness, Planet* planet, char dim[]) {
-    Origin* o = createOrigin(dim, planet);
-    if (o == NULL) {
+Jerry *createJerry_with_planet(jerry_store store, char id[], int happiness, Planet* planet, char dim[]) {
+    if (dim == NULL) {
         memoryProb = true;
         return NULL;
     }
-    Jerry *j = createJerry(id, happiness, o);
+    char *canonical = internName(dim);
+    if (canonical == NULL) return NULL;
+    Jerry *j = createJerry(store, id, happiness, planet, canonical);
     if (j == NULL) {
         memoryProb = true;
-        delOrigin(&o);
         return NULL;
     }
     return j;
@@ -72,106 +589,56 @@ Planet* createPlanet(char name[], float x, float y, float z) {
         memoryProb = true;
         return NULL;
     }
-    p->name = (char *)malloc(strlen(name) + 1);
+    p->name = internName(name);
     if (p->name == NULL) {
         delPlanet(&p);
-        memoryProb = true;
         return NULL;
     }
-    strcpy(p->name, name);
     p->cordinate[0] = x;
     p->cordinate[1] = y;
     p->cordinate[2] = z;
     return p;
 }
 
-PhysicalCharacteristics *createPhysChar(char name[], float val) {
-    if (name == NULL) {
-        memoryProb = true;
-        return NULL;
-    }
-    PhysicalCharacteristics *p = (PhysicalCharacteristics *)malloc(sizeof(PhysicalCharacteristics));
-    if (p == NULL) {
-        memoryProb = true;
-        return NULL;
-    }
-    p->name = (char *)malloc(strlen(name) + 1);
-    if (p->name == NULL) {
-        delPhysChar(&p);
-        memoryProb = true;
-        return NULL;
-    }
-    strcpy(p->name, name);
-    p->val = val;
-    return p;
-}
-
-/**
- * @function createOrigin
- * @brief Creates and initializes a new Origin object with the given dimension and associated planet.
- *
- * This function allocates memory for a new Origin structure, assigns the provided dimension string
- * and the associated planet pointer, and initializes the dimension by allocating memory for it.
- *
- * @param dim A string representing the dimension of the origin.
- * @param planet A pointer to the Planet structure associated with the origin.
- *
- * @return Origin* A pointer to the newly created Origin object, or NULL if memory allocation fails.
- *
- * @note This function may set a global flag `memoryProb` to `true` if memory allocation fails.
- */
-Origin *createOrigin(char dim[], Planet* planet) {
-    if (dim == NULL || planet == NULL) {
-        memoryProb = true;
-        return NULL;
-    }
-    Origin *o = (Origin *)malloc(sizeof(Origin));
-    if (o == NULL) {
-        memoryProb = true;
-        return NULL;
-    }
-    o->dim = (char *)malloc(strlen(dim) + 1);
-    if (o->dim == NULL) {
-        delOrigin(&o);
-        memoryProb = true;
-        return NULL;
-    }
-    strcpy(o->dim, dim);
-    o->planet = planet;
-    return o;
-}
-
 bool physExcit(Jerry *j, char name[]) {
     if (j == NULL || name == NULL) {
         memoryProb = true;
         return false;
     }
-    for (int i = 0; i < j->phys_num; i++) {
-        if (strcmp(j->phys_char[i]->name, name) == 0) {
+    char *canonical = findName(name);
+    for (int i = 0; canonical != NULL && i < j->phys_num; i++) {
+        if (getPhysName(j, i) == canonical) {
             return true;
         }
     }
     return false;
 }
 
-status addPhys(Jerry *j, PhysicalCharacteristics *p) {
-    if (j == NULL || p == NULL) {
+status addPhys(Jerry *j, char name[], float val) {
+    if (j == NULL || name == NULL) {
         memoryProb = true;
         return failure;
     }
+    char *canonical = internName(name);
+    if (canonical == NULL) return failure;
     for (int i = 0; i < j->phys_num; i++) {
-        if (strcmp(j->phys_char[i]->name, p->name) == 0) {
+        if (getPhysName(j, i) == canonical) {
             return failure;
         }
     }
-    j->phys_num++;
-    PhysicalCharacteristics **new_arr = (PhysicalCharacteristics **)realloc(j->phys_char, j->phys_num * sizeof(PhysicalCharacteristics *));
-    if (new_arr == NULL && j->phys_num > 0) {
+    int column = find_column(j->store, canonical);
+    if (column == -1) {
         memoryProb = true;
         return failure;
     }
-    j->phys_char = new_arr;
-    j->phys_char[j->phys_num-1] = p;
+    int *new_arr = (int *)realloc(j->phys, (j->phys_num + 1) * sizeof(int));
+    if (new_arr == NULL) {
+        memoryProb = true;
+        return failure;
+    }
+    j->phys = new_arr;
+    j->phys[j->phys_num++] = column;
+    j->store->columns[column].values[j->ordinal] = val;
     return success;
 }
 
@@ -183,29 +650,28 @@ status delPhysByName(Jerry *j, char physName[]) {
     if (!physExcit(j, physName)) {
         return failure;
     }
+    char *canonical = findName(physName);
     bool move = false;
     for (int i = 0; i < j->phys_num; i++) {
-        if (strcmp(j->phys_char[i]->name, physName) == 0) {
-            delPhysChar(&(j->phys_char[i]));
+        if (getPhysName(j, i) == canonical) {
             move = true;
-
         }
         else if (move == true) {
-            j->phys_char[i-1] = j->phys_char[i];
+            j->phys[i-1] = j->phys[i];
         }
     }
     j->phys_num--;
     if (j->phys_num == 0) {
-        free(j->phys_char);
-        j->phys_char = NULL;
+        free(j->phys);
+        j->phys = NULL;
         return success;
     }
-    PhysicalCharacteristics **p = (PhysicalCharacteristics **)realloc(j->phys_char, j->phys_num * sizeof(PhysicalCharacteristics *));
+    int *p = (int *)realloc(j->phys, j->phys_num * sizeof(int));
     if (p == NULL && j->phys_num > 0) {
         memoryProb = true;
         return failure;
     }
-    j->phys_char = p;
+    j->phys = p;
     return success;
 }
 
@@ -214,20 +680,21 @@ status printJerry(Jerry *j) {
         memoryProb = true;
         return failure;
     }
+    Planet *planet = getPlanet(j);
     printf("Jerry , ID - %s : \n"
            "Happiness level : %d \n"
            "Origin : %s \n"
            "Planet : %s (%.2f,%.2f,%.2f) \n",
-           j->id, j->happines_level, j->origin->dim, j->origin->planet->name,
-           j->origin->planet->cordinate[0], j->origin->planet->cordinate[1],j->origin->planet->cordinate[2]);
+           j->id, getHappiness(j), getDimension(j), planet->name,
+           planet->cordinate[0], planet->cordinate[1],planet->cordinate[2]);
     if (j->phys_num > 0) {
        printf("Jerry's physical Characteristics available : \n");
         printf("\t");
        for (int i = 0; i < j->phys_num; i++) {
            if (i != j->phys_num-1){
-               printf("%s : %.2f , ", j->phys_char[i]->name, j->phys_char[i]->val);
+               printf("%s : %.2f , ", getPhysName(j, i), getPhysVal(j, i));
            }else {
-               printf("%s : %.2f \n", j->phys_char[i]->name, j->phys_char[i]->val);
+               printf("%s : %.2f \n", getPhysName(j, i), getPhysVal(j, i));
            }
        }
     }
@@ -247,27 +714,6 @@ status delPlanet(Planet **p) {
     if (p == NULL) {
         return failure;
     }
-    free((*p)->name);
-    free(*p);
-    *p = NULL;
-    return success;
-}
-
-status delOrigin(Origin **o) {
-    if (o == NULL) {
-        return failure;
-    }
-    free((*o)->dim);
-    free(*o);
-    *o = NULL;
-    return success;
-}
-
-status delPhysChar(PhysicalCharacteristics **p) {
-    if (p == NULL) {
-        return failure;
-    }
-    free((*p)->name);
     free(*p);
     *p = NULL;
     return success;
@@ -277,22 +723,34 @@ status delJerry(Jerry **j) {
     if (j == NULL) {
         return failure;
     }
-    for (int i = 0; i < (*j)->phys_num; i++) {
-        delPhysChar(&(*j)->phys_char[i]);
+    //the last row moves into the freed one, together with the characteristic values of its Jerry
+    jerry_store store = (*j)->store;
+    int hole = (*j)->ordinal;
+    int last = --store->size;
+    cohort *c = &store->cohorts[store->cohort_of[hole]];
+    unlink_row(&c->buckets[bucket_of(store->happiness[hole])], store->bucket_prev, store->bucket_next, hole);
+    unlink_row(&c->arrivals, store->arrival_prev, store->arrival_next, hole);
+    c->size--;
+    if (hole != last) {
+        Jerry *moved = store->jerries[last];
+        store->jerries[hole] = moved;
+        store->happiness[hole] = store->happiness[last];
+        store->planet[hole] = store->planet[last];
+        store->dim[hole] = store->dim[last];
+        store->arrival[hole] = store->arrival[last];
+        store->cohort_of[hole] = store->cohort_of[last];
+        c = &store->cohorts[store->cohort_of[last]];
+        relink_row(&c->buckets[bucket_of(store->happiness[last])], store->bucket_prev, store->bucket_next, last, hole);
+        relink_row(&c->arrivals, store->arrival_prev, store->arrival_next, last, hole);
+        for (int i = 0; i < moved->phys_num; i++) {
+            float *values = store->columns[moved->phys[i]].values;
+            values[hole] = values[last];
+        }
+        moved->ordinal = hole;
     }
-    free((*j)->phys_char);
-    delOrigin(&(*j)->origin);
+    free((*j)->phys);
     free((*j)->id);
     free(*j);
     *j = NULL;
     return success;
 }
-
-
-
-
-
-
-
-
-
@@ -7,6 +7,7 @@
 #include <stdio.h>
 
 #include "Defs.h"
+#include "LinkedList.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -16,7 +17,7 @@
  * @brief Represents a planet with a name and 3D coordinates.
  *
  * Members:
- *   - char *name: A pointer to a string that holds the planet's name.
+ *   - char *name: A pointer to a string that holds the planet's name (interned, see `internName`).
  *   - float cordinate[3]: An array of three floats representing the planet's
  *                         coordinates in 3D space (x, y, z).
  */
@@ -25,59 +26,226 @@ typedef struct {
     float cordinate[3];
 } Planet;
 
-/**
- * @typedef Origin
- * @brief Represents an origin point associated with a planet and a dimension.
- *
- * Members:
- *   - Planet *planet: A pointer to a Planet structure associated with the origin.
- *   - char *dim: A pointer to a string that describes the dimension of the origin.
- */
-typedef struct {
- Planet *planet;
- char *dim;
-} Origin;
-
-/**
- * @typedef PhysicalCharacteristics
- * @brief Represents a physical characteristic with a name and a value.
- *
- * Members:
- *   - char *name: A pointer to a string that holds the name of the characteristic.
- *   - float val: The value of the physical characteristic.
- */
-typedef struct {
-    char *name;
-    float val;
-} PhysicalCharacteristics;
+typedef struct jerry_store_rec* jerry_store;
 
 /**
  * @typedef Jerry
- * @brief Represents a Jerry with various attributes including ID, happiness level, origin, and physical characteristics.
+ * @brief Represents a Jerry: a view of one row of the columnar store holding the Jerries.
+ *
+ * The attributes scanned across all Jerries (happiness level, planet, dimension and the values of
+ * the physical characteristics) are not kept in the Jerry itself but in contiguous columns of its
+ * `jerry_store`, at the row given by its ordinal; they are read through `getHappiness`,
+ * `getPlanet`, `getDimension`, `getPhysName` and `getPhysVal`.
  *
  * Members:
  *   - char *id: A pointer to a string that holds the Jerry's unique identifier.
- *   - int happines_level: The happiness level of the Jerry.
- *   - Origin *origin: A pointer to the Origin structure representing the Jerry's origin.
+ *   - jerry_store store: The store holding the columns of the Jerry.
+ *   - int ordinal: The dense number of the Jerry in its store, i.e. its row in every column.
+ *          It changes when another Jerry is deleted (see `delJerry`).
  *   - int phys_num: The number of physical characteristics the Jerry possesses.
- *   - PhysicalCharacteristics **phys_char: A pointer to an array of pointers to
- *          PhysicalCharacteristics structures, representing the Jerry's physical traits.
+ *   - int *phys: The columns of the Jerry's physical characteristics, in the order they were added.
+ *   - list_link daycareLink: The links of the Jerry in the intrusive daycare list,
+ *          so joining and leaving the daycare allocates and searches nothing.
  *
 */
 typedef struct {
     char *id;
-    int happines_level;
-    Origin *origin;
+    jerry_store store;
+    int ordinal;
     int phys_num;
-    PhysicalCharacteristics **phys_char;
+    int *phys;
+    list_link daycareLink;
 } Jerry;
 
+/**
+ * @function internName
+ * @brief Retrieves the canonical copy of a planet, dimension or physical characteristic name.
+ *
+ * All the names of planets, dimensions and physical characteristics are interned in one pool:
+ * each distinct name is stored once however many Jerries share it, and two names are equal
+ * exactly when they are the same pointer. Interned names must not be modified or freed; they
+ * stay valid until `releaseNames` is called.
+ *
+ * @param name The name to intern.
+ *
+ * @return char* The canonical copy of the name, or NULL if memory allocation fails.
+ *
+ * @note This function may set a global flag `memoryProb` to `true` if memory allocation fails.
+ */
+char *internName(char name[]);
+/**
+ * @function findName
+ * @brief Retrieves the canonical copy of a name without interning it.
+ *
+ * A name that was never interned is held by no planet, dimension or physical characteristic, so
+ * lookups of names typed by the user start here.
+ *
+ * @param name The name to search for.
+ *
+ * @return char* The canonical copy of the name, or NULL if the name is unknown.
+ */
+char *findName(char name[]);
+/**
+ * @function releaseNames
+ * @brief Frees all the interned names, once nothing holds them any more.
+ */
+void releaseNames(void);
+/**
+ * @function createJerryStore
+ * @brief Creates an empty columnar store of Jerries.
+ *
+ * The store keeps one contiguous column per attribute: happiness levels, planets, dimensions, and
+ * one column of values per physical characteristic name. The Jerries of a store are numbered by
+ * dense ordinals, and the row `i` of every column belongs to the Jerry with ordinal `i`, so a
+ * scan of one attribute over all the Jerries reads that attribute alone, one row after another.
+ *
+ * @return jerry_store A pointer to the new store, or NULL if memory allocation fails.
+ *
+ * @note This function may set a global flag `memoryProb` to `true` if memory allocation fails.
+ */
+jerry_store createJerryStore(void);
+/**
+ * @function getJerryStoreSize
+ * @brief Retrieves the number of Jerries in a store; their ordinals run from 0 to this number minus one.
+ *
+ * @param store A pointer to the store.
+ *
+ * @return int The number of Jerries, or 0 if the store is NULL.
+ */
+int getJerryStoreSize(jerry_store store);
+/**
+ * @function getJerryByOrdinal
+ * @brief Retrieves the Jerry holding an ordinal of a store.
+ *
+ * @param store A pointer to the store.
+ * @param ordinal The ordinal of the Jerry.
+ *
+ * @return Jerry* The Jerry, or NULL if the store is NULL or no Jerry holds the ordinal.
+ */
+Jerry *getJerryByOrdinal(jerry_store store, int ordinal);
+/**
+ * @function applyActivity
+ * @brief Records an activity of all the Jerries of a store, applied to their happiness levels lazily.
+ *
+ * An activity takes every level below `min` down by `subtraction`, every other level up by `add`,
+ * and clamps the result to [0, 100]. Since it leaves one of only 101 levels, the activities after
+ * the first one pending are composed into a table of 101 levels instead of being applied to every
+ * Jerry. A Jerry's level is resolved through the table when it is read (see `getHappiness`).
+ *
+ * The Jerries joining the store after an activity must not go through it, so they start a new
+ * cohort with a table of its own. Every cohort is more than twice as big as the next one, and a
+ * cohort outgrowing that is merged into the one before after the activities of both are applied
+ * to their levels, so each Jerry's level is brought up to date O(log n) times over its stay. A
+ * store has O(log n) cohorts, and recording an activity costs O(101 log n) whatever the number of
+ * activities and check-ins in between. The queue of the saddest Jerries needs no update either
+ * (see `findSaddestJerries`).
+ *
+ * @param store A pointer to the store.
+ * @param min The happiness threshold.
+ * @param subtraction The amount subtracted from the levels below the threshold.
+ * @param add The amount added to the other levels.
+ */
+void applyActivity(jerry_store store, int min, int subtraction, int add);
+/**
+ * @function findSaddestJerries
+ * @brief Finds the Jerries with the lowest happiness levels of a store, saddest first.
+ *
+ * Every cohort of the store (see `applyActivity`) keeps its Jerries in a bucket queue: a bucket
+ * per happiness level from 0 to 100, each in the order the Jerries joined the store, and two
+ * buckets for the levels below 0 and above 100 that only Jerries untouched by any activity can
+ * have. Check-ins and check-outs update the queue in O(1). A pending activity moves no Jerry
+ * between buckets, since all the Jerries of a bucket still share one level, so the buckets are
+ * grouped by that level once, and the saddest Jerries are read level after level, merging by
+ * arrival only the buckets that share a level; with no activity pending, every level has a single
+ * bucket, which is walked in order. The Jerries of the buckets below 0 and above 100 resolve each
+ * on their own and are kept in a heap built once. The cost is O(101 log n + outer + count * shared),
+ * whatever the number of Jerries in the store, where outer is the number of Jerries with levels
+ * outside [0, 100] before the activities, and shared the number of buckets that share a level (1
+ * with no activity pending). Jerries sharing a level come in the order they joined the store.
+ *
+ * @param store A pointer to the store.
+ * @param saddest Output array receiving the Jerries, with room for `count` of them.
+ * @param count The largest number of Jerries to find.
+ *
+ * @return int The number of Jerries found: `count`, or fewer if the store holds fewer Jerries.
+ *
+ * @note This function may set a global flag `memoryProb` to `true` if memory allocation fails.
+ */
+int findSaddestJerries(jerry_store store, Jerry **saddest, int count);
+/**
+ * @function findSaddestJerry
+ * @brief Finds the Jerry with the lowest happiness level of a store.
+ *
+ * Among the Jerries sharing the lowest level, the one that joined the store first is returned.
+ * It is read from the bucket queues of the store (see `findSaddestJerries`), in O(101 log n + outer) steps.
+ *
+ * @param store A pointer to the store.
+ *
+ * @return Jerry* The saddest Jerry, or NULL if the store is NULL or empty.
+ */
+Jerry *findSaddestJerry(jerry_store store);
+/**
+ * @function destroyJerryStore
+ * @brief Frees a store and its columns. Its Jerries must be deleted first.
+ *
+ * @param store A pointer to the store. The function performs no operation if it is NULL.
+ */
+void destroyJerryStore(jerry_store store);
+/**
+ * @function getHappiness
+ * @brief Retrieves the happiness level of a Jerry from the happiness column of its store.
+ *
+ * The activities still pending in the store are resolved for this Jerry alone, in O(1).
+ *
+ * @param j A pointer to the Jerry structure.
+ *
+ * @return int The happiness level of the Jerry.
+ */
+int getHappiness(Jerry *j);
+/**
+ * @function getPlanet
+ * @brief Retrieves the planet a Jerry comes from.
+ *
+ * @param j A pointer to the Jerry structure.
+ *
+ * @return Planet* The planet of the Jerry.
+ */
+Planet *getPlanet(Jerry *j);
+/**
+ * @function getDimension
+ * @brief Retrieves the dimension a Jerry comes from.
+ *
+ * @param j A pointer to the Jerry structure.
+ *
+ * @return char* The interned name of the dimension (see `internName`).
+ */
+char *getDimension(Jerry *j);
+/**
+ * @function getPhysName
+ * @brief Retrieves the name of one of the physical characteristics of a Jerry.
+ *
+ * @param j A pointer to the Jerry structure.
+ * @param i The position of the characteristic, from 0 to `phys_num` minus one.
+ *
+ * @return char* The interned name of the characteristic (see `internName`).
+ */
+char *getPhysName(Jerry *j, int i);
+/**
+ * @function getPhysVal
+ * @brief Retrieves the value of one of the physical characteristics of a Jerry from the column of the characteristic.
+ *
+ * @param j A pointer to the Jerry structure.
+ * @param i The position of the characteristic, from 0 to `phys_num` minus one.
+ *
+ * @return float The value of the characteristic for the Jerry.
+ */
+float getPhysVal(Jerry *j, int i);
 /**
  * @function createPlanet
  * @brief Creates and initializes a new Planet object with the given name and 3D coordinates.
  *
  * This function allocates memory for a new Planet structure, assigns the provided name and coordinates
- * (x, y, z) to the planet, and initializes the name by allocating memory for it.
+ * (x, y, z) to the planet, and takes the interned copy of the name.
  *
  * @param name A string representing the planet's name.
  * @param x The x-coordinate of the planet.
@@ -89,27 +257,13 @@ typedef struct {
  * @note This function may set a global flag `memoryProb` to `true` if memory allocation fails.
  */
 Planet *createPlanet(char name[], float x, float y, float z);
-/**
- * @function createPhysChar
- * @brief Creates and initializes a new PhysicalCharacteristics object with the given name and value.
- *
- * This function allocates memory for a new PhysicalCharacteristics structure, assigns the provided name
- * and value to the characteristic, and initializes the name by allocating memory for it.
- *
- * @param name A string representing the name of the physical characteristic.
- * @param val The value of the physical characteristic.
- *
- * @return PhysicalCharacteristics* A pointer to the newly created PhysicalCharacteristics object, or NULL if memory allocation fails.
- *
- * @note This function may set a global flag `memoryProb` to `true` if memory allocation fails.
- */
-PhysicalCharacteristics *createPhysChar(char name[], float val);
 /**
  * @function physExcit
  * @brief Checks if a specific physical characteristic exists for a given Jerry.
  *
  * This function iterates through the array of physical characteristics of a Jerry and compares
- * each characteristic's name with the provided name. It returns `true` if a match is found,
+ * each characteristic's interned name with the interned copy of the provided name, so no strings
+ * are compared. It returns `true` if a match is found,
  * indicating that the physical characteristic exists for the Jerry; otherwise, it returns `false`.
  *
  * @param j A pointer to the Jerry structure.
@@ -123,19 +277,22 @@ bool physExcit(Jerry *j, char name[]);
  * @brief Adds a new physical characteristic to a Jerry if it doesn't already exist.
  *
  * This function checks if the given physical characteristic already exists for the Jerry by comparing
- * its name with the existing physical characteristics. If the characteristic doesn't exist, it is added
- * to the Jerry's list of physical characteristics. The function reallocates memory for the characteristics array
- * and updates the `phys_num` to reflect the new addition.
+ * the interned copy of its name with the existing physical characteristics. If the characteristic doesn't
+ * exist, it is added to the Jerry's list of physical characteristics and its value is stored in the column
+ * of the characteristic, which is created the first time a Jerry of the store gets the characteristic.
+ * The function reallocates memory for the characteristics array and updates the `phys_num` to reflect
+ * the new addition.
  *
  * @param j A pointer to the Jerry structure.
- * @param p A pointer to the PhysicalCharacteristics structure to add.
+ * @param name A string representing the name of the physical characteristic.
+ * @param val The value of the physical characteristic.
  *
  * @return status Returns `success` if the physical characteristic was added,
  *         or `failure` if the characteristic already exists or if memory allocation fails.
  *
  * @note This function may set a global flag `memoryProb` to `true` if memory allocation fails.
  */
-status addPhys(Jerry *j, PhysicalCharacteristics *p);
+status addPhys(Jerry *j, char name[], float val);
 /**
  * @function delPhysByName
  * @brief Deletes a physical characteristic from a Jerry by its name.
@@ -155,7 +312,7 @@ status addPhys(Jerry *j, PhysicalCharacteristics *p);
 status delPhysByName(Jerry *j, char physName[]);
 /**
 * @function printJerry
-* @brief Prints the details of a Jerry object, including its ID, happiness level, origin, planet, and physical characteristics.
+* @brief Prints the details of a Jerry object, including its ID, happiness level, dimension, planet, and physical characteristics.
 *
 * This function prints information about the Jerry, such as its ID, happiness level, origin dimension, associated planet,
 * and the planet's coordinates. If the Jerry has any physical characteristics, it prints each characteristic's name and value.
@@ -182,7 +339,7 @@ status printPlanet(Planet *p);
  *@function delPlanet
  * @brief Frees the memory allocated for a planet and its associated resources.
  *
- * This function frees the memory allocated for the planet's name and the planet object itself.
+ * This function frees the memory allocated for the planet object itself; its interned name is kept.
  * It also sets the caller's pointer to `NULL` to prevent a dangling pointer.
  *
  * @param[in,out] p A pointer to the pointer of the `Planet` object to be freed.
@@ -196,47 +353,13 @@ status printPlanet(Planet *p);
  *       and it should no longer be used.
  */
 status delPlanet(Planet **p);
-/**
-* @brief Frees the memory allocated for an origin and its associated resources.
-*
-* This function frees the memory allocated for the dimension string and the `Origin` object itself.
-* It also sets the caller's pointer to `NULL` to prevent a dangling pointer.
-*
-* @param o A pointer to the pointer of the `Origin` object to be freed.
-*                   After the function, the caller's `Origin *` pointer will be set to `NULL`.
-*
-* @return status The status of the operation:
-*                 - `success` if the memory was successfully freed and the pointer was set to `NULL`.
-*                 - `failure` if the provided pointer is `NULL` or if any memory freeing operation fails.
-*
-* @note After calling this function, the caller's `Origin *` pointer will be set to `NULL`,
-*       and it should no longer be used.
-*/
-status delOrigin(Origin **o);
-/**
- *@function delPhysChar
- * @brief Frees the memory allocated for a physical characteristic and its associated resources.
- *
- * This function frees the memory allocated for the name string and the `PhysicalCharacteristics` object itself.
- * It also sets the caller's pointer to `NULL` to prevent a dangling pointer.
- *
- * @param p A pointer to the pointer of the `PhysicalCharacteristics` object to be freed.
- *                   After the function, the caller's `PhysicalCharacteristics *` pointer will be set to `NULL`.
- *
- * @return status The status of the operation:
- *                 - `success` if the memory was successfully freed and the pointer was set to `NULL`.
- *                 - `failure` if the provided pointer is `NULL` or if any memory freeing operation fails.
- *
- * @note After calling this function, the caller's `PhysicalCharacteristics *` pointer will be set to `NULL`,
- *       and it should no longer be used.
- */
-status delPhysChar(PhysicalCharacteristics **p);
 /**
  *@function delJerry
  * @brief Frees the memory allocated for a Jerry object and its associated resources.
  *
- * This function frees the memory allocated for the `Jerry` object, including its physical characteristics,
- * origin, and other associated resources. It also sets the caller's pointer to `NULL` to prevent a dangling pointer.
+ * This function frees the memory allocated for the `Jerry` object and gives its row back to its store. To keep
+ * the ordinals dense, the Jerry holding the last ordinal of the store moves into the freed row and takes the
+ * ordinal of the deleted Jerry. It also sets the caller's pointer to `NULL` to prevent a dangling pointer.
  *
  * @param[in,out] j A pointer to the pointer of the `Jerry` object to be freed.
  *                   After the function, the caller's `Jerry *` pointer will be set to `NULL`.
@@ -252,10 +375,12 @@ status delJerry(Jerry **j);
 /**
  * @brief Creates a new Jerry with a specified origin planet and dimension.
  *
- * This function creates a Jerry by first initializing its origin with the provided
- * planet and dimension. If any part of the creation process fails, the function
- * handles memory cleanup and sets the global `memoryProb` flag.
+ * This function creates a Jerry in the next row of a store, which gives it the next ordinal,
+ * and writes its happiness level, planet and interned dimension into the columns of the store.
+ * If any part of the creation process fails, the function handles memory cleanup and sets
+ * the global `memoryProb` flag.
  *
+ * @param store The store holding the Jerry.
  * @param id The ID of the Jerry (string).
  * @param happiness The initial happiness level of the Jerry (integer).
  * @param planet Pointer to the Jerry's origin planet.
@@ -268,6 +393,6 @@ status delJerry(Jerry **j);
  * @note If memory allocation fails at any step, the function cleans up
  *       partially created structures to prevent memory leaks.
  */
-Jerry *createJerry_with_planet(char id[], int happiness, Planet* planet, char dim[]);
+Jerry *createJerry_with_planet(jerry_store store, char id[], int happiness, Planet* planet, char dim[]);
 
 #endif //JERRY_H
@@ -1,42 +1,74 @@
 #include <stdio.h>
 #include "Defs.h"
 #include "LinkedList.h"
+#include "IndexedList.h"
 #include "HashTable.h"
 #include "MultiValueHashTable.h"
+#include "OrderedIndex.h"
+#include "Bitmap.h"
+#include "KeyValuePair.h"
+#include "Allocator.h"
+#include "HashFunctions.h"
 #include "Jerry.h"
 #include <math.h>
 
+/** The number of pairs and list nodes allocated together by the slab pool of the characteristics table. */
+#define SLAB_OBJECTS 1024
+
+/**
+ * @brief The indexes of one physical characteristic.
+ *
+ * Members:
+ *   - byValue: The Jerries having the characteristic, sorted by its value.
+ *   - members: The ordinals of the same Jerries, for combining characteristics.
+ */
+typedef struct {
+    ordered_index byValue;
+    bitmap members;
+} phys_index;
+
 bool memoryProb = false;
-void preprocess(Planet **planet_array, linked_list jerry_list, char confi[], int planet_num);
+void preprocess(Planet **planet_array, jerry_store store, intrusive_list jerry_list, char confi[], int planet_num);
 Element fake_copy(Element element);
 status fake_free(Element element);
 bool comp_by_id(Element id_1, Element id_2);
+int order_by_id(Element id_1, Element id_2);
 status jerry_elem_print(Element element);
 Element jerry_get_id(Element element);
 status str_as_elem_print(Element element);
 status free_jerry_elem(Element element);
-int str_to_num(Element element);
-status str_as_elem_free(Element element);
-Element str_as_elem_copy(Element element);
+bool same_name(Element name_1, Element name_2);
+uint64_t name_hash(Element name, uint64_t seed);
 bool jerry_as_elem_comp(Element j_1, Element j_2);
+uint64_t jerry_as_elem_hash(Element j, uint64_t seed);
+status index_as_elem_free(Element element);
+status index_as_elem_print(Element element);
+void take_ordinal(jerry_store store, hashTable index_t, Jerry* j);
+status index_phys(hashTable index_t, char* phys_name, float val, Jerry* j);
+void unindex_phys(hashTable index_t, char* phys_name, float val, Jerry* j);
 void print_main_menu();
-void close_program(MultiValueHashTable mtv, linked_list list, hashTable table, Planet** p_arr, int planet_num);
+void close_program(MultiValueHashTable mtv, hashTable index_t, jerry_store store, intrusive_list list, indexed_list pages, hashTable table,
+    slab_pool pool, Planet** p_arr, int planet_num);
 void valid_input_check(char input[], int* out_p_hold);
 Planet* find_planet(Planet** p_arr, char* planet_name, int planet_num);
-status add_to_system(MultiValueHashTable mtv, linked_list list, hashTable table, Jerry* j);
-void adjust_happiness(linked_list jerry_l, int min, int subtraction, int add);
+status page_jerry(indexed_list pages, Jerry* j);
+status add_to_system(MultiValueHashTable mtv, hashTable index_t, intrusive_list list, indexed_list pages, hashTable table, Jerry* j);
+void fill_tables(intrusive_list jerry_l, indexed_list jerry_p, hashTable id_t, MultiValueHashTable phys_t, hashTable index_t);
+void adjust_happiness(jerry_store store, intrusive_list jerry_l, int min, int subtraction, int add);
 bool isPrime(int number);
 int nextPrime(int number);
-void option_1(MultiValueHashTable phys_t, hashTable id_t, linked_list jerry_l, Planet** p_arr, int planet_num , char* buffer);
-void option_2(MultiValueHashTable phys_t, hashTable id_t, char* buffer);
-void option_3(MultiValueHashTable phys_t, hashTable id_t, char* buffer);
-void remove_jerry_from_system(MultiValueHashTable phys_t, hashTable id_t, linked_list jerry_l, Jerry* j);
-void option_4(MultiValueHashTable phys_t, hashTable id_t, linked_list jerry_l, char* buffer);
-Jerry* find_closest_jerry_by_phys(linked_list ll , char* phys_name, float val);
-void option_5(MultiValueHashTable phys_t, hashTable id_t, linked_list jerry_l, char* buffer);
-void option_6(MultiValueHashTable phys_t, hashTable id_t, linked_list jerry_l);
-void option_7(MultiValueHashTable phys_t, linked_list jerry_l, Planet** p_arr, int planet_num , char* buffer);
-void option_8(linked_list jerry_l, char* buffer);
+void option_1(MultiValueHashTable phys_t, hashTable index_t, jerry_store store, hashTable id_t, intrusive_list jerry_l, indexed_list jerry_p, Planet** p_arr, int planet_num , char* buffer);
+void option_2(MultiValueHashTable phys_t, hashTable index_t, hashTable id_t, char* buffer);
+void option_3(MultiValueHashTable phys_t, hashTable index_t, hashTable id_t, char* buffer);
+void remove_jerry_from_system(MultiValueHashTable phys_t, hashTable index_t, jerry_store store, hashTable id_t, intrusive_list jerry_l, indexed_list jerry_p, Jerry* j);
+void option_4(MultiValueHashTable phys_t, hashTable index_t, jerry_store store, hashTable id_t, intrusive_list jerry_l, indexed_list jerry_p, char* buffer);
+Jerry* find_closest_jerry_by_phys(hashTable index_t, char* phys_name, float val);
+void option_5(MultiValueHashTable phys_t, hashTable index_t, jerry_store store, hashTable id_t, intrusive_list jerry_l, indexed_list jerry_p, char* buffer);
+void option_6(MultiValueHashTable phys_t, hashTable index_t, jerry_store store, hashTable id_t, intrusive_list jerry_l, indexed_list jerry_p);
+void option_7(MultiValueHashTable phys_t, hashTable index_t, jerry_store store, intrusive_list jerry_l, indexed_list jerry_p, Planet** p_arr, int planet_num , char* buffer);
+void find_jerries_by_phys_combination(hashTable index_t, jerry_store store, char* buffer);
+void find_saddest_jerries(jerry_store store);
+void option_8(jerry_store store, intrusive_list jerry_l, char* buffer);
 
 int main(int argc, char **argv) {
     /**
@@ -67,11 +99,17 @@ int main(int argc, char **argv) {
     int planet_num = atoi(argv[1]);
     Planet **planet_array = (Planet **) malloc(planet_num * sizeof(Planet *));
     if (planet_array == NULL) memoryProb = true;
-    linked_list jerry_list = createLinkedList(fake_copy, comp_by_id, jerry_elem_print, free_jerry_elem, jerry_get_id);
+    //the attributes of the Jerries live in the columns of the store, the Jerries themselves being views of its rows
+    jerry_store store = createJerryStore();
+    intrusive_list jerry_list = createIntrusiveList(offsetof(Jerry, daycareLink), jerry_elem_print, free_jerry_elem);
     if (jerry_list == NULL) memoryProb = true;
-    preprocess(planet_array, jerry_list, argv[2], planet_num);
+    //the same Jerries ordered by ID, so that any page of them is reached by its rank
+    indexed_list jerry_pages = createIndexedList(fake_copy, comp_by_id, jerry_elem_print, fake_free, jerry_get_id);
+    if (jerry_pages == NULL) memoryProb = true;
+    if (!memoryProb) preprocess(planet_array, store, jerry_list, argv[2], planet_num);
     if (memoryProb) {
-        destroyList(jerry_list);
+        destroyIntrusiveList(jerry_list);
+        destroyIndexedList(jerry_pages);
         if (planet_array != NULL) {
             for (int i = 0; i < planet_num; i++) {
                 if (planet_array[i] != NULL) {
@@ -81,25 +119,35 @@ int main(int argc, char **argv) {
             free(planet_array);
         }
     }
-    int next_prime = nextPrime(getLengthList(jerry_list));
-    hashTable id_table = createHashTable(fake_copy, fake_free, str_as_elem_print, fake_copy,
+    int next_prime = nextPrime(getLengthIntrusiveList(jerry_list));
+    //IDs like Jerry12 and Jerry21 may collide, so the tables keyed by IDs and names chain their buckets:
+    //long chains become trees ordered by hash, and by the keys themselves when their hashes are equal
+    hashTable id_table = createHashTableWithEngine(fake_copy, fake_free, str_as_elem_print, fake_copy,
         fake_free, jerry_elem_print, comp_by_id,
-        str_to_num, next_prime);
+        wyhashString, next_prime, chainingEngine);
     if (id_table == NULL) memoryProb = true;
-    MultiValueHashTable phys_table = createMultiValueHashTable(str_as_elem_copy, str_as_elem_free,
-        str_as_elem_print,fake_copy, fake_free, jerry_elem_print, comp_by_id,
-        jerry_as_elem_comp,str_to_num, next_prime);
+    else setHashTableKeyCompare(id_table, order_by_id);
+    //the characteristics are keyed by their interned names, which are neither copied nor compared as strings
+    //the pairs and list nodes of the characteristics table are carved from one slab pool
+    size_t small_object = getKeyValuePairSize() > sizeof(node_rec) ? getKeyValuePairSize() : sizeof(node_rec);
+    slab_pool pool = createSlabPool(small_object, SLAB_OBJECTS);
+    if (pool == NULL) memoryProb = true;
+    MultiValueHashTable phys_table = createMultiValueHashTableWithAllocator(fake_copy, fake_free,
+        str_as_elem_print,fake_copy, fake_free, jerry_elem_print, same_name,
+        jerry_as_elem_comp,name_hash, next_prime, getSlabAllocator(pool));
     if(phys_table == NULL) memoryProb = true;
-    Element elem;
-    if (!memoryProb && getLengthList(jerry_list) > 0) {
-        list_forEach(elem, jerry_list) {
-            Jerry* temp = (Jerry*) elem;
-            addToHashTable(id_table,temp->id,temp );
-            for (int i=0; i < temp->phys_num; i++) {
-                PhysicalCharacteristics* phys = temp->phys_char[i];
-                addToMultiValueHashTable(phys_table, phys->name, temp);
-            }
-        }
+    else {
+        setMultiValueHashTableKeyCompare(phys_table, order_by_id);
+        setMultiValueHashTableValueHash(phys_table, jerry_as_elem_hash);
+    }
+    //every characteristic also keeps its Jerries sorted by value, for the nearest value searches
+    hashTable index_table = createHashTableWithEngine(fake_copy, fake_free, str_as_elem_print,
+        fake_copy, index_as_elem_free, index_as_elem_print, same_name,
+        name_hash, next_prime, chainingEngine);
+    if (index_table == NULL) memoryProb = true;
+    else setHashTableKeyCompare(index_table, order_by_id);
+    if (!memoryProb && getLengthIntrusiveList(jerry_list) > 0) {
+        fill_tables(jerry_list, jerry_pages, id_table, phys_table, index_table);
     }
     int user_input;
     char buffer[301];
@@ -112,31 +160,31 @@ int main(int argc, char **argv) {
         }
         switch (user_input) {
             case 1:
-                option_1(phys_table, id_table, jerry_list, planet_array, planet_num, buffer);
+                option_1(phys_table, index_table, store, id_table, jerry_list, jerry_pages, planet_array, planet_num, buffer);
                 break;
             case 2:
-                option_2(phys_table, id_table, buffer);
+                option_2(phys_table, index_table, id_table, buffer);
                 break;
             case 3:
-                option_3(phys_table, id_table, buffer);
+                option_3(phys_table, index_table, id_table, buffer);
                 break;
             case 4:
-                option_4(phys_table, id_table, jerry_list, buffer);
+                option_4(phys_table, index_table, store, id_table, jerry_list, jerry_pages, buffer);
                 break;
             case 5:
-                option_5(phys_table, id_table, jerry_list, buffer);
+                option_5(phys_table, index_table, store, id_table, jerry_list, jerry_pages, buffer);
                 break;
             case 6:
-                option_6(phys_table, id_table, jerry_list);
+                option_6(phys_table, index_table, store, id_table, jerry_list, jerry_pages);
                 break;
             case 7:
-                option_7(phys_table, jerry_list, planet_array, planet_num, buffer);
+                option_7(phys_table, index_table, store, jerry_list, jerry_pages, planet_array, planet_num, buffer);
                 break;
             case 8:
-                option_8(jerry_list, buffer);
+                option_8(store, jerry_list, buffer);
                 break;
             case 9:
-                close_program(phys_table, jerry_list, id_table, planet_array, planet_num);
+                close_program(phys_table, index_table, store, jerry_list, jerry_pages, id_table, pool, planet_array, planet_num);
                 if (memoryProb) {
                     printf("A memory problem has been detected in the program \n");
                     exit(1);
@@ -150,7 +198,7 @@ int main(int argc, char **argv) {
     }
 }
 
-void preprocess(Planet **planet_array, linked_list jerry_list, char confi[], int planet_num) {
+void preprocess(Planet **planet_array, jerry_store store, intrusive_list jerry_list, char confi[], int planet_num) {
     /**
  * @brief Processes a configuration file to initialize planets and Jerries.
  *
@@ -161,6 +209,7 @@ void preprocess(Planet **planet_array, linked_list jerry_list, char confi[], int
  * their physical characteristics, and adds them to the provided linked list.
  *
  * @param planet_array Pointer to an array for storing planet objects.
+ * @param store Pointer to the store receiving the columns of the Jerries.
  * @param jerry_list Linked list for storing Jerry objects.
  * @param confi The file path to the configuration file.
  * @param planet_num The number of planets to be processed.
@@ -241,8 +290,9 @@ void preprocess(Planet **planet_array, linked_list jerry_list, char confi[], int
                 strcpy(jerry_dim, jerry_token);
                 jerry_token = strtok(NULL, ",");
                 Planet *jerry_planet = NULL;
-                for (int i = 0; i < planet_num; i++) {
-                    if (strcmp(planet_array[i]->name,jerry_token) == 0) {
+                char *planet_name = findName(jerry_token);
+                for (int i = 0; planet_name != NULL && i < planet_num; i++) {
+                    if (planet_array[i]->name == planet_name) {
                         jerry_planet = planet_array[i];
                     }
                 }
@@ -251,13 +301,13 @@ void preprocess(Planet **planet_array, linked_list jerry_list, char confi[], int
                 }
                 jerry_token = strtok(NULL, ",");
                 int jerry_hap = atoi(jerry_token);
-                Jerry *temp_jerry = createJerry_with_planet(jerry_id, jerry_hap, jerry_planet,jerry_dim);
+                Jerry *temp_jerry = createJerry_with_planet(store, jerry_id, jerry_hap, jerry_planet,jerry_dim);
                 if (temp_jerry == NULL) {
                     memoryProb = true;
                     break;
                 }
                 new_jerry = temp_jerry;
-                if (appendNode(jerry_list, new_jerry) == failure) memoryProb = true;
+                if (linkElement(jerry_list, new_jerry) == failure) memoryProb = true;
             }
 
             //add the physical characters to the jerry
@@ -270,13 +320,9 @@ void preprocess(Planet **planet_array, linked_list jerry_list, char confi[], int
                 //update the token to the value part
                 phys_token = strtok(NULL, ":");
                 float phys_val = atof(phys_token);
-                PhysicalCharacteristics *temp_phys = createPhysChar(pyhs_name, phys_val);
-                if (temp_phys == NULL) {
-                    memoryProb = true;
-                    break;
-                }
                 // add the physical character to the current jerry processed
-                addPhys(new_jerry, temp_phys);
+                addPhys(new_jerry, pyhs_name, phys_val);
+                if (memoryProb) break;
             }
         }
     }
@@ -311,6 +357,21 @@ bool comp_by_id(Element id_1, Element id_2) {
     return false;
 }
 
+int order_by_id(Element id_1, Element id_2) {
+    /**
+ * @brief Orders two IDs (or characteristic names) alphabetically.
+ *
+ * Used by the hash tables to keep buckets with many colliding keys balanced.
+ *
+ * @param id_1 The first ID to compare (as an element).
+ * @param id_2 The second ID to compare (as an element).
+ *
+ * @return A negative number, 0 or a positive number if the first ID is smaller than,
+ *         equal to or greater than the second.
+ */
+    return strcmp((char*)id_1, (char*)id_2);
+}
+
 status jerry_elem_print(Element element) {
     /**
  * @brief Prints a Jerry object.
@@ -382,46 +443,6 @@ status free_jerry_elem(Element element) {
     return success;
 }
 
-int str_to_num(Element element) {
-    /**
- * @brief Converts a string to a numeric value.
- *
- * This function calculates a numeric value for a given string by summing the ASCII values
- * of its characters. It is typically used as a hash function for strings.
- *
- * @param element The string to be converted (as an element).
- *
- * @return
- * - The numeric representation of the string.
- * - `0` if the input element is `NULL`.
- */
-    if (element == NULL) return 0;
-    char* str = (char*) element;
-    int res = 0;
-    while (*str) {
-        res = res + *str; // Shift left and add ASCII value
-        str++;
-    }
-    return res;
-}
-
-status str_as_elem_free(Element element) {
-    /**
- * @brief Frees a string when treated as an element.
- *
- * This function deallocates memory for a string represented as an element.
- *
- * @param element The string to be freed (as an element).
- *
- * @return
- * - `success` if the string is successfully freed.
- * - `failure` if the input element is `NULL`.
- */
-    if (element == NULL) return failure;
-    free((char*) element);
-    return success;
-}
-
 bool isPrime(int number) {
     /**
      * @brief Checks if a number is prime.
@@ -476,23 +497,33 @@ int nextPrime(int number) {
     return candidate;
 }
 
-Element str_as_elem_copy(Element element) {
+bool same_name(Element name_1, Element name_2) {
     /**
- * @brief Creates a copy of a string when treated as an element.
+ * @brief Compares two interned names for equality.
  *
- * This function allocates memory for a new string and copies the content of the input string into it.
+ * Interned names are equal exactly when they are the same copy (see `internName`), so no
+ * characters are compared.
  *
- * @param element The string to be copied (as an element).
+ * @param name_1 The first interned name (as an element).
+ * @param name_2 The second interned name (as an element).
  *
  * @return
- * - A pointer to the newly allocated copy of the string.
- * - `NULL` if the input element is `NULL` or memory allocation fails.
+ * - `true` if the names are equal.
+ * - `false` otherwise.
  */
-    if (element == NULL) return NULL;
-    char* temp = (char*) element;
-    char* copy = (char*) malloc(sizeof(char) * strlen(temp) + 1);
-    strcpy(copy, temp);
-    return copy;
+    return name_1 == name_2;
+}
+
+uint64_t name_hash(Element name, uint64_t seed) {
+    /**
+ * @brief Hashes an interned name by its address, consistently with `same_name`.
+ *
+ * @param name The interned name (as an element).
+ * @param seed The seed of the hash.
+ *
+ * @return The hash of the name's address.
+ */
+    return wyhashBytes(&name, sizeof(name), seed);
 }
 
 bool jerry_as_elem_comp(Element j_1, Element j_2) {
@@ -513,6 +544,128 @@ bool jerry_as_elem_comp(Element j_1, Element j_2) {
     return res;
 }
 
+uint64_t jerry_as_elem_hash(Element j, uint64_t seed) {
+    /**
+ * @brief Hashes a Jerry object by its ID, consistently with `jerry_as_elem_comp`.
+ *
+ * Lets the characteristics table index the Jerries of popular characteristics.
+ *
+ * @param j The Jerry object (as an element).
+ * @param seed The seed of the hash.
+ *
+ * @return The hash of the Jerry's ID.
+ */
+    return wyhashString(((Jerry*) j)->id, seed);
+}
+
+status index_as_elem_free(Element element) {
+    /**
+ * @brief Frees the indexes of a physical characteristic, as an element of the table of indexes.
+ *
+ * @param element The indexes (as an element).
+ *
+ * @return `success`.
+ */
+    phys_index* index = (phys_index*) element;
+    destroyOrderedIndex(index->byValue);
+    destroyBitmap(index->members);
+    free(index);
+    return success;
+}
+
+status index_as_elem_print(Element element) {
+    /**
+ * @brief Prints the Jerries of a physical characteristic by increasing value.
+ *
+ * @param element The indexes of the characteristic (as an element).
+ *
+ * @return
+ * - `success` if the Jerries are printed.
+ * - `failure` if the element is `NULL`.
+ */
+    if (element == NULL) return failure;
+    return displayOrderedIndex(((phys_index*) element)->byValue);
+}
+
+void take_ordinal(jerry_store store, hashTable index_t, Jerry* j) {
+    /**
+ * @brief Prepares the bitmaps for the ordinal of a Jerry checking out to be taken back.
+ *
+ * Deleting the Jerry moves the Jerry with the last ordinal of the store into the freed one (see
+ * `delJerry`), so the bitmaps of its physical characteristics are updated ahead of the move. The
+ * Jerry checking out must already be out of the bitmaps.
+ *
+ * @param store Pointer to the store holding the columns of the Jerries.
+ * @param index_t Pointer to the hash table of the indexes of the physical characteristics.
+ * @param j Pointer to the Jerry.
+ *
+ * @return Void.
+ */
+    Jerry* last = getJerryByOrdinal(store, getJerryStoreSize(store) - 1);
+    if (last != j) {
+        for (int i=0; i < last->phys_num; i++) {
+            phys_index* index = (phys_index*) borrowFromHashTable(index_t, getPhysName(last, i));
+            removeFromBitmap(index->members, last->ordinal);
+            if (addToBitmap(index->members, j->ordinal) == failure) memoryProb = true;
+        }
+    }
+}
+
+status index_phys(hashTable index_t, char* phys_name, float val, Jerry* j) {
+    /**
+ * @brief Adds a Jerry to the indexes of one of its physical characteristics.
+ *
+ * The indexes of the characteristic are created when its first Jerry is added. The Jerry must
+ * already have its ordinal.
+ *
+ * @param index_t Pointer to the hash table of the indexes of the physical characteristics.
+ * @param phys_name The interned name of the physical characteristic.
+ * @param val The value of the characteristic for the Jerry.
+ * @param j Pointer to the Jerry.
+ *
+ * @return
+ * - `success` if the Jerry is indexed.
+ * - `failure` if memory allocation fails.
+ */
+    phys_index* index = (phys_index*) borrowFromHashTable(index_t, phys_name);
+    if (index == NULL) {
+        index = (phys_index*) malloc(sizeof(phys_index));
+        if (index == NULL) return failure;
+        index->byValue = createOrderedIndex(fake_copy, jerry_as_elem_comp, jerry_elem_print, fake_free);
+        index->members = createBitmap();
+        if (index->byValue == NULL || index->members == NULL || addToHashTable(index_t, phys_name, index) == failure) {
+            index_as_elem_free(index);
+            return failure;
+        }
+    }
+    if (addToBitmap(index->members, j->ordinal) == failure) return failure;
+    if (insertToOrderedIndex(index->byValue, val, j) == failure) {
+        removeFromBitmap(index->members, j->ordinal);
+        return failure;
+    }
+    return success;
+}
+
+void unindex_phys(hashTable index_t, char* phys_name, float val, Jerry* j) {
+    /**
+ * @brief Removes a Jerry from the indexes of one of its physical characteristics.
+ *
+ * The indexes of the characteristic are freed once they hold no Jerry.
+ *
+ * @param index_t Pointer to the hash table of the indexes of the physical characteristics.
+ * @param phys_name The interned name of the physical characteristic.
+ * @param val The value of the characteristic for the Jerry.
+ * @param j Pointer to the Jerry.
+ *
+ * @return Void.
+ */
+    phys_index* index = (phys_index*) borrowFromHashTable(index_t, phys_name);
+    if (index == NULL) return;
+    removeFromOrderedIndex(index->byValue, val, j);
+    removeFromBitmap(index->members, j->ordinal);
+    if (getLengthOrderedIndex(index->byValue) == 0) removeFromHashTable(index_t, phys_name);
+}
+
 void print_main_menu() {
     printf("Welcome Rick, what are your Jerry's needs today ? \n"
                   "1 : Take this Jerry away from me \n"
@@ -526,24 +679,33 @@ void print_main_menu() {
                   "9 : I had enough. Close this place \n");
 }
 
-void close_program(MultiValueHashTable mtv, linked_list list, hashTable table, Planet** p_arr, int planet_num) {
+void close_program(MultiValueHashTable mtv, hashTable index_t, jerry_store store, intrusive_list list, indexed_list pages, hashTable table,
+    slab_pool pool, Planet** p_arr, int planet_num) {
     /**
  * @brief Frees all allocated resources and closes the program.
  *
  * This function deallocates all memory associated with the program, including the multi-value
- * hash table, linked list, hash table, and planet array.
+ * hash table, linked list, hash table, and planet array, and finally the interned names they held.
  *
  * @param mtv Pointer to the multi-value hash table.
+ * @param index_t Pointer to the hash table of the indexes of the physical characteristics.
+ * @param store Pointer to the store holding the columns of the Jerries.
  * @param list Pointer to the linked list.
+ * @param pages Pointer to the indexed list of the Jerries ordered by ID.
  * @param table Pointer to the hash table.
+ * @param pool Pointer to the slab pool of the multi-value hash table, freed once the table is destroyed.
  * @param p_arr Pointer to the array of planets.
  * @param planet_num The number of planets in the array.
  *
  * @return Void. The function has no return value.
  */
     destroyMultiValueHashTable(mtv);
+    destroySlabPool(pool);
+    destroyHashTable(index_t);
     destroyHashTable(table);
-    destroyList(list);
+    destroyIndexedList(pages);
+    destroyIntrusiveList(list);
+    destroyJerryStore(store);
     if (p_arr != NULL) {
         for (int i = 0; i < planet_num; i++) {
             if (p_arr[i] != NULL) {
@@ -552,6 +714,7 @@ void close_program(MultiValueHashTable mtv, linked_list list, hashTable table, P
         }
         free(p_arr);
     }
+    releaseNames();
 }
 
 void valid_input_check(char input[], int* out_p_hold) {
@@ -591,15 +754,33 @@ Planet* find_planet(Planet** p_arr, char* planet_name,int planet_num) {
  * - A pointer to the planet if found.
  * - `NULL` if the planet is not found or the input is invalid.
  */
-    for (int i = 0; i < planet_num; i++) {
-        if (strcmp(p_arr[i]->name,planet_name) == 0) {
+    char* name = findName(planet_name);
+    for (int i = 0; name != NULL && i < planet_num; i++) {
+        if (p_arr[i]->name == name) {
             return p_arr[i];
         }
     }
     return NULL;
 }
 
-status add_to_system(MultiValueHashTable mtv, linked_list list, hashTable table, Jerry* j) {
+status page_jerry(indexed_list pages, Jerry* j) {
+    /**
+    * @brief Inserts a Jerry into the indexed list of the Jerries at the rank of its ID.
+    *
+    * The rank is found by walking down the skip list, so keeping the list ordered by ID takes
+    * O(log n) expected steps per Jerry.
+    *
+    * @param pages Pointer to the indexed list of the Jerries ordered by ID.
+    * @param j Pointer to the Jerry object to be inserted.
+    *
+    * @return
+    * - `success` if the Jerry is inserted.
+    * - `failure` if memory allocation fails.
+    */
+    return insertToIndexedList(pages, rankInIndexedList(pages, j->id, order_by_id), j);
+}
+
+status add_to_system(MultiValueHashTable mtv, hashTable index_t, intrusive_list list, indexed_list pages, hashTable table, Jerry* j) {
     /**
     * @brief Adds a Jerry to the system, updating all relevant data structures.
     *
@@ -607,7 +788,9 @@ status add_to_system(MultiValueHashTable mtv, linked_list list, hashTable table,
     * hash table by its physical characteristics. All data structures will point to the same Jerry object.
     *
     * @param mtv Pointer to the multi-value hash table for physical characteristics.
-    * @param list Pointer to the linked list of Jerries.
+    * @param index_t Pointer to the hash table of the indexes of the physical characteristics.
+    * @param list Pointer to the intrusive list of Jerries.
+    * @param pages Pointer to the indexed list of the Jerries ordered by ID.
     * @param table Pointer to the hash table of Jerries indexed by their ID.
     * @param j Pointer to the Jerry object to be added.
     *
@@ -616,16 +799,75 @@ status add_to_system(MultiValueHashTable mtv, linked_list list, hashTable table,
     * - `failure` if any of the additions fail.
     */
     if (j == NULL) return failure;
-    if (appendNode(list, j) == failure) return failure;
+    if (linkElement(list, j) == failure) return failure;
+    if (page_jerry(pages, j) == failure) return failure;
     if (addToHashTable(table, j->id, j) == failure) return failure;
     for (int i=0; i < j->phys_num; i++) {
-        PhysicalCharacteristics* phys = j->phys_char[i];
-        if (addToMultiValueHashTable(mtv, phys->name, j) == failure) return failure;
+        if (addToMultiValueHashTable(mtv, getPhysName(j, i), j) == failure) return failure;
+        if (index_phys(index_t, getPhysName(j, i), getPhysVal(j, i), j) == failure) return failure;
     }
     return success;
 }
 
-void remove_jerry_from_system(MultiValueHashTable phys_t, hashTable id_t, linked_list jerry_l, Jerry* j) {
+void fill_tables(intrusive_list jerry_l, indexed_list jerry_p, hashTable id_t, MultiValueHashTable phys_t, hashTable index_t) {
+    /**
+     * @brief Indexes all the Jerries read from the configuration file.
+     *
+     * The IDs and the physical characteristics of all Jerries are collected first and added to
+     * the tables with the batched operations, which overlap the memory latency of the insertions.
+     *
+     * @param jerry_l Pointer to the intrusive list of Jerries.
+     * @param jerry_p Pointer to the indexed list of the same Jerries, ordered by ID.
+     * @param id_t Pointer to the hash table of Jerries indexed by their ID.
+     * @param phys_t Pointer to the multi-value hash table for physical characteristics.
+     * @param index_t Pointer to the hash table of the indexes of the physical characteristics.
+     *
+     * @note Sets `memoryProb` if memory allocation fails.
+     */
+    int jerry_num = getLengthIntrusiveList(jerry_l);
+    int phys_num = 0;
+    Element elem;
+    intrusive_forEach(elem, jerry_l) {
+        phys_num += ((Jerry*) elem)->phys_num;
+    }
+    Element* ids = (Element*) malloc(jerry_num * sizeof(Element));
+    Element* jerries = (Element*) malloc((jerry_num + phys_num) * sizeof(Element));
+    Element* names = (Element*) malloc((phys_num > 0 ? phys_num : 1) * sizeof(Element));
+    if (ids == NULL || jerries == NULL || names == NULL) {
+        memoryProb = true;
+        free(ids);
+        free(jerries);
+        free(names);
+        return;
+    }
+    //jerries holds the values of the id table followed by the values of the characteristics table
+    int j_idx = 0, p_idx = 0;
+    intrusive_forEach(elem, jerry_l) {
+        Jerry* temp = (Jerry*) elem;
+        ids[j_idx] = temp->id;
+        jerries[j_idx++] = temp;
+        for (int i=0; i < temp->phys_num; i++) {
+            names[p_idx] = getPhysName(temp, i);
+            jerries[jerry_num + p_idx++] = temp;
+        }
+    }
+    addManyToHashTable(id_t, ids, jerries, jerry_num, NULL);
+    addManyToMultiValueHashTable(phys_t, names, jerries + jerry_num, phys_num);
+    intrusive_forEach(elem, jerry_l) {
+        Jerry* temp = (Jerry*) elem;
+        if (page_jerry(jerry_p, temp) == failure) memoryProb = true;
+        for (int i=0; i < temp->phys_num; i++) {
+            if (index_phys(index_t, getPhysName(temp, i), getPhysVal(temp, i), temp) == failure) {
+                memoryProb = true;
+            }
+        }
+    }
+    free(ids);
+    free(jerries);
+    free(names);
+}
+
+void remove_jerry_from_system(MultiValueHashTable phys_t, hashTable index_t, jerry_store store, hashTable id_t, intrusive_list jerry_l, indexed_list jerry_p, Jerry* j) {
     /**
      * @brief Removes a Jerry from the system, updating all relevant data structures.
      *
@@ -634,63 +876,61 @@ void remove_jerry_from_system(MultiValueHashTable phys_t, hashTable id_t, linked
      * in the system's data structures are cleared.
      *
      * @param phys_t Pointer to the multi-value hash table for physical characteristics.
+     * @param index_t Pointer to the hash table of the indexes of the physical characteristics.
+     * @param store Pointer to the store holding the columns of the Jerries.
      * @param id_t Pointer to the hash table of Jerries indexed by their ID.
-     * @param jerry_l Pointer to the linked list of Jerries.
+     * @param jerry_l Pointer to the intrusive list of Jerries.
+     * @param jerry_p Pointer to the indexed list of the same Jerries, ordered by ID.
      * @param j Pointer to the Jerry object to be removed.
      *
      * @return Void. The function modifies the data structures directly.
      */
     for (int i=0; i < j->phys_num; i++) {
-        removeFromMultiValueHashTable(phys_t, j->phys_char[i]->name, j);
+        removeFromMultiValueHashTable(phys_t, getPhysName(j, i), j);
+        unindex_phys(index_t, getPhysName(j, i), getPhysVal(j, i), j);
     }
+    take_ordinal(store, index_t, j);
     removeFromHashTable(id_t, j->id);
-    deleteNode(jerry_l, j);
+    removeFromIndexedList(jerry_p, rankInIndexedList(jerry_p, j->id, order_by_id));
+    //the Jerry is unlinked through its own links, without walking the list
+    deleteElement(jerry_l, j);
 }
 
-Jerry* find_closest_jerry_by_phys(linked_list ll , char* phys_name, float val) {
+Jerry* find_closest_jerry_by_phys(hashTable index_t, char* phys_name, float val) {
     /**
      * @brief Finds the closest Jerry based on a specified physical characteristic value.
      *
-     * This function iterates through a linked list of Jerries to find the Jerry whose
-     * physical characteristic value is closest to the specified value for the given
-     * physical characteristic name.
+     * This function searches the ordered index of the physical characteristic for the Jerry whose
+     * value is closest to the specified value. Only the Jerries just below and just above the
+     * value are compared, so the search takes O(log n) steps. Among equally close Jerries, the
+     * one that got the characteristic first is chosen.
      *
-     * @param ll Pointer to the linked list of Jerries.
+     * @param index_t Pointer to the hash table of the indexes of the physical characteristics.
      * @param phys_name The name of the physical characteristic to compare.
      * @param val The target value for the physical characteristic.
      *
      * @return
      * - A pointer to the Jerry with the closest physical characteristic value.
-     * - `NULL` if no matching physical characteristic is found in the list.
+     * - `NULL` if no Jerry has the physical characteristic.
      */
-    Element elem;
-    Jerry* min_j = NULL;
-    float min_dif = INFINITY;
-    list_forEach(elem, ll) {
-        Jerry* j = (Jerry*) elem;
-        for (int i=0; i < j->phys_num; i++) {
-            if (strcmp(phys_name, j->phys_char[i]->name) == 0) {
-                if (fabs(val - j->phys_char[i]->val) < min_dif) {
-                    min_dif = fabs(val - j->phys_char[i]->val);
-                    min_j = j;
-                }
-                continue;
-            }
-        }
-    }
-    return min_j;
+    phys_index* index = (phys_index*) borrowFromHashTable(index_t, findName(phys_name));
+    if (index == NULL) return NULL;
+    return (Jerry*) nearestInOrderedIndex(index->byValue, val);
 }
 
-void adjust_happiness(linked_list jerry_l, int min, int subtraction, int add) {
+void adjust_happiness(jerry_store store, intrusive_list jerry_l, int min, int subtraction, int add) {
     /**
-     * @brief Adjusts the happiness levels of all Jerries in the linked list.
+     * @brief Adjusts the happiness levels of all Jerries in the daycare.
      *
-     * This function modifies the happiness level of each Jerry in the linked list based on
-     * a minimum threshold. If a Jerry's happiness level is below the threshold, it is
-     * decreased by a specified value. Otherwise, it is increased. The happiness level is
-     * capped at 100 and floored at 0.
+     * This function modifies the happiness level of each Jerry based on a minimum threshold.
+     * If a Jerry's happiness level is below the threshold, it is decreased by a specified
+     * value. Otherwise, it is increased. The happiness level is capped at 100 and floored at 0.
+     * The activity is recorded by the store and composed with the activities before it, in
+     * O(101) steps per arrival cohort (see `applyActivity`); the levels of the Jerries are
+     * resolved when they are read.
      *
-     * @param jerry_l Pointer to the linked list of Jerries.
+     * @param store Pointer to the store holding the columns of the Jerries.
+     * @param jerry_l Pointer to the intrusive list of Jerries.
      * @param min The minimum happiness threshold.
      * @param subtraction The amount to subtract from happiness if below the threshold.
      * @param add The amount to add to happiness if above the threshold.
@@ -698,22 +938,12 @@ void adjust_happiness(linked_list jerry_l, int min, int subtraction, int add) {
      * @return Void. The function modifies the Jerries' happiness levels directly and prints
      *         the updated list at the end.
      */
-    Element elem;
-    list_forEach(elem, jerry_l) {
-        Jerry* j = (Jerry*) elem;
-        if (j->happines_level < min) {
-            j->happines_level = j->happines_level - subtraction;
-        }else {
-            j->happines_level = j->happines_level + add;
-        }
-        if (j->happines_level > 100) j->happines_level = 100;
-        if (j->happines_level < 0) j->happines_level = 0;
-    }
+    applyActivity(store, min, subtraction, add);
     printf("The activity is now over ! \n");
-    displayList(jerry_l);
+    displayIntrusiveList(jerry_l);
 }
 
-void option_1(MultiValueHashTable phys_t, hashTable id_t, linked_list jerry_l, Planet** p_arr, int planet_num , char* buffer) {
+void option_1(MultiValueHashTable phys_t, hashTable index_t, jerry_store store, hashTable id_t, intrusive_list jerry_l, indexed_list jerry_p, Planet** p_arr, int planet_num , char* buffer) {
     /**
      * @brief Adds a new Jerry to the system based on user input.
      *
@@ -723,8 +953,11 @@ void option_1(MultiValueHashTable phys_t, hashTable id_t, linked_list jerry_l, P
      * multi-value hash table for physical characteristics.
      *
      * @param phys_t Pointer to the multi-value hash table for physical characteristics.
+     * @param index_t Pointer to the hash table of the indexes of the physical characteristics.
+     * @param store Pointer to the store holding the columns of the Jerries.
      * @param id_t Pointer to the hash table for Jerries indexed by ID.
-     * @param jerry_l Pointer to the linked list of Jerries.
+     * @param jerry_l Pointer to the intrusive list of Jerries.
+     * @param jerry_p Pointer to the indexed list of the same Jerries, ordered by ID.
      * @param p_arr Pointer to the array of planets.
      * @param planet_num The number of planets in the array.
      * @param buffer A temporary buffer for user input.
@@ -734,7 +967,7 @@ void option_1(MultiValueHashTable phys_t, hashTable id_t, linked_list jerry_l, P
      */
     printf("What is your Jerry's ID ? \n");
     scanf("%s", buffer);
-    if (lookupInHashTable(id_t, buffer) != NULL) {
+    if (borrowFromHashTable(id_t, buffer) != NULL) {
         printf("Rick did you forgot ? you already left him here ! \n");
         return;
     }
@@ -764,14 +997,14 @@ void option_1(MultiValueHashTable phys_t, hashTable id_t, linked_list jerry_l, P
     printf("How happy is your Jerry now ? \n");
     int hap;
     scanf("%d", &hap);
-    Jerry *j = createJerry_with_planet(id, hap, planet, dimension);
+    Jerry *j = createJerry_with_planet(store, id, hap, planet, dimension);
     if (j == NULL) {
         memoryProb = true;
         free(id);
         free(dimension);
         return;
     }
-    if (add_to_system(phys_t, jerry_l, id_t, j) == failure) {
+    if (add_to_system(phys_t, index_t, jerry_l, jerry_p, id_t, j) == failure) {
         memoryProb = true;
         free(id);
         free(dimension);
@@ -782,7 +1015,7 @@ void option_1(MultiValueHashTable phys_t, hashTable id_t, linked_list jerry_l, P
     printJerry(j);
 }
 
-void option_2(MultiValueHashTable phys_t, hashTable id_t, char* buffer) {
+void option_2(MultiValueHashTable phys_t, hashTable index_t, hashTable id_t, char* buffer) {
     /**
      * @brief Adds a new physical characteristic to an existing Jerry.
      *
@@ -791,6 +1024,7 @@ void option_2(MultiValueHashTable phys_t, hashTable id_t, char* buffer) {
      * and the system's multi-value hash table.
      *
      * @param phys_t Pointer to the multi-value hash table for physical characteristics.
+     * @param index_t Pointer to the hash table of the indexes of the physical characteristics.
      * @param id_t Pointer to the hash table for Jerries indexed by ID.
      * @param buffer A temporary buffer for user input.
      *
@@ -799,7 +1033,7 @@ void option_2(MultiValueHashTable phys_t, hashTable id_t, char* buffer) {
      */
     printf("What is your Jerry's ID ? \n");
     scanf("%s", buffer);
-    Jerry* j = (Jerry*) lookupInHashTable(id_t, buffer);
+    Jerry* j = (Jerry*) borrowFromHashTable(id_t, buffer);
     if (j == NULL) {
         printf("Rick this Jerry is not in the daycare ! \n");
         return;
@@ -813,23 +1047,22 @@ void option_2(MultiValueHashTable phys_t, hashTable id_t, char* buffer) {
     float val;
     printf("What is the value of his %s ? \n", buffer);
     scanf("%f", &val);
-    PhysicalCharacteristics *p = createPhysChar(buffer, val);
-    if (p == NULL) {
+    if (addPhys(j, buffer, val) == failure) return;
+    char* phys_name = findName(buffer);
+    if (addToMultiValueHashTable(phys_t, phys_name, j) == failure) {
         memoryProb = true;
         return;
     }
-    if (addPhys(j, p) == failure) return;
-    if (addToMultiValueHashTable(phys_t, p->name, j) == failure) {
-        delPhysChar(&p);
+    if (index_phys(index_t, phys_name, val, j) == failure) {
         memoryProb = true;
         return;
     }
-    linked_list l = (linked_list) lookupInMultiValueHashTable(phys_t, p->name);
-    printf("%s : \n", p->name);
+    linked_list l = (linked_list) lookupInMultiValueHashTable(phys_t, phys_name);
+    printf("%s : \n", phys_name);
     displayList(l);
 }
 
-void option_3(MultiValueHashTable phys_t, hashTable id_t, char* buffer) {
+void option_3(MultiValueHashTable phys_t, hashTable index_t, hashTable id_t, char* buffer) {
     /**
      * @brief Removes a physical characteristic from an existing Jerry.
      *
@@ -838,6 +1071,7 @@ void option_3(MultiValueHashTable phys_t, hashTable id_t, char* buffer) {
      * and the Jerry is removed from the corresponding node in the multi-value hash table.
      *
      * @param phys_t Pointer to the multi-value hash table for physical characteristics.
+     * @param index_t Pointer to the hash table of the indexes of the physical characteristics.
      * @param id_t Pointer to the hash table for Jerries indexed by ID.
      * @param buffer A temporary buffer for user input.
      *
@@ -845,7 +1079,7 @@ void option_3(MultiValueHashTable phys_t, hashTable id_t, char* buffer) {
      */
     printf("What is your Jerry's ID ? \n");
     scanf("%s", buffer);
-    Jerry* j = (Jerry*) lookupInHashTable(id_t, buffer);
+    Jerry* j = (Jerry*) borrowFromHashTable(id_t, buffer);
     if (j == NULL) {
         printf("Rick this Jerry is not in the daycare ! \n");
         return;
@@ -856,12 +1090,20 @@ void option_3(MultiValueHashTable phys_t, hashTable id_t, char* buffer) {
         printf("The information about his %s not available to the daycare ! \n", buffer);
         return;
     }
+    //the value is needed to find the Jerry in the ordered index, so it is removed from there first
+    char* phys_name = findName(buffer);
+    for (int i=0; i < j->phys_num; i++) {
+        if (getPhysName(j, i) == phys_name) {
+            unindex_phys(index_t, phys_name, getPhysVal(j, i), j);
+            break;
+        }
+    }
     delPhysByName(j, buffer);
-    removeFromMultiValueHashTable(phys_t,buffer, j);
+    removeFromMultiValueHashTable(phys_t, phys_name, j);
     printJerry(j);
 }
 
-void option_4(MultiValueHashTable phys_t, hashTable id_t, linked_list jerry_l, char* buffer) {
+void option_4(MultiValueHashTable phys_t, hashTable index_t, jerry_store store, hashTable id_t, intrusive_list jerry_l, indexed_list jerry_p, char* buffer) {
     /**
      * @brief Removes a Jerry from the daycare system.
      *
@@ -869,24 +1111,27 @@ void option_4(MultiValueHashTable phys_t, hashTable id_t, linked_list jerry_l, c
      * from the linked list, hash table by ID, and the multi-value hash table for physical characteristics.
      *
      * @param phys_t Pointer to the multi-value hash table for physical characteristics.
+     * @param index_t Pointer to the hash table of the indexes of the physical characteristics.
+     * @param store Pointer to the store holding the columns of the Jerries.
      * @param id_t Pointer to the hash table for Jerries indexed by ID.
-     * @param jerry_l Pointer to the linked list of Jerries.
+     * @param jerry_l Pointer to the intrusive list of Jerries.
+     * @param jerry_p Pointer to the indexed list of the same Jerries, ordered by ID.
      * @param buffer A temporary buffer for user input.
      *
      * @return Void. The function directly updates the system's data structures.
      */
     printf("What is your Jerry's ID ? \n");
     scanf("%s", buffer);
-    Jerry* j = (Jerry*) lookupInHashTable(id_t, buffer);
+    Jerry* j = (Jerry*) borrowFromHashTable(id_t, buffer);
     if (j == NULL) {
         printf("Rick this Jerry is not in the daycare ! \n");
         return;
     }
-    remove_jerry_from_system(phys_t, id_t, jerry_l, j);
+    remove_jerry_from_system(phys_t, index_t, store, id_t, jerry_l, jerry_p, j);
     printf("Rick thank you for using our daycare service ! Your Jerry awaits ! \n");
 }
 
-void option_5(MultiValueHashTable phys_t, hashTable id_t, linked_list jerry_l, char* buffer) {
+void option_5(MultiValueHashTable phys_t, hashTable index_t, jerry_store store, hashTable id_t, intrusive_list jerry_l, indexed_list jerry_p, char* buffer) {
     /**
      * @brief Finds and removes the closest matching Jerry based on a physical characteristic.
      *
@@ -895,75 +1140,81 @@ void option_5(MultiValueHashTable phys_t, hashTable id_t, linked_list jerry_l, c
      * for the specified characteristic and removes it from the daycare system.
      *
      * @param phys_t Pointer to the multi-value hash table for physical characteristics.
+     * @param index_t Pointer to the hash table of the indexes of the physical characteristics.
+     * @param store Pointer to the store holding the columns of the Jerries.
      * @param id_t Pointer to the hash table for Jerries indexed by ID.
-     * @param jerry_l Pointer to the linked list of Jerries.
+     * @param jerry_l Pointer to the intrusive list of Jerries.
+     * @param jerry_p Pointer to the indexed list of the same Jerries, ordered by ID.
      * @param buffer A temporary buffer for user input.
      *
      * @return Void. The function directly updates the system's data structures.
      */
     printf("What do you remember about your Jerry ? \n");
     scanf("%s", buffer);
-    linked_list ll = (linked_list) lookupInMultiValueHashTable(phys_t,buffer);
-    if (ll == NULL) {
+    if (borrowFromHashTable(index_t, findName(buffer)) == NULL) {
         printf("Rick we can not help you - we do not know any Jerry's %s ! \n", buffer);
         return;
     }
     float val;
     printf("What do you remember about the value of his %s ? \n", buffer);
     scanf("%f", &val);
-    Jerry* j = find_closest_jerry_by_phys(ll, buffer, val);
+    Jerry* j = find_closest_jerry_by_phys(index_t, buffer, val);
     printf("Rick this is the most suitable Jerry we found : \n");
     printJerry(j);
-    remove_jerry_from_system(phys_t, id_t, jerry_l, j);
+    remove_jerry_from_system(phys_t, index_t, store, id_t, jerry_l, jerry_p, j);
     printf("Rick thank you for using our daycare service ! Your Jerry awaits ! \n");
 }
 
-void option_6(MultiValueHashTable phys_t, hashTable id_t, linked_list jerry_l) {
+void option_6(MultiValueHashTable phys_t, hashTable index_t, jerry_store store, hashTable id_t, intrusive_list jerry_l, indexed_list jerry_p) {
     /**
      * @brief Finds and removes the least happy Jerry from the daycare system.
      *
-     * This function identifies the Jerry with the lowest happiness level in the daycare system
-     * and removes it from the linked list, hash table by ID, and the multi-value hash table for
-     * physical characteristics.
+     * This function identifies the Jerry with the lowest happiness level in the daycare system,
+     * without scanning the Jerries (see `findSaddestJerry`), and removes it from the linked list,
+     * hash table by ID, and the multi-value hash table for physical characteristics.
      *
      * @param phys_t Pointer to the multi-value hash table for physical characteristics.
+     * @param index_t Pointer to the hash table of the indexes of the physical characteristics.
+     * @param store Pointer to the store holding the columns of the Jerries.
      * @param id_t Pointer to the hash table for Jerries indexed by ID.
-     * @param jerry_l Pointer to the linked list of Jerries.
+     * @param jerry_l Pointer to the intrusive list of Jerries.
+     * @param jerry_p Pointer to the indexed list of the same Jerries, ordered by ID.
      *
      * @return Void. The function directly updates the system's data structures.
      *
      * @note If no Jerries are present in the daycare, the function prints a message and exits without action.
      */
-    if (getLengthList(jerry_l) == 0) {
+    if (getLengthIntrusiveList(jerry_l) == 0) {
         printf("Rick we can not help you - we currently have no Jerries in the daycare ! \n");
         return;
     }
     printf("Rick this is the most suitable Jerry we found : \n");
-    Element elem;
-    Jerry* min_j = NULL;
-    float min_hap = INFINITY;
-    list_forEach(elem, jerry_l) {
-        Jerry* j = (Jerry*) elem;
-        if (j->happines_level < min_hap) {
-            min_hap = j->happines_level;
-            min_j = j;
-        }
-    }
+    //the saddest Jerry is read from the bucket queue of the store; ties still go to the Jerry that arrived first
+    Jerry* min_j = findSaddestJerry(store);
     printJerry(min_j);
-    remove_jerry_from_system(phys_t, id_t, jerry_l, min_j);
+    remove_jerry_from_system(phys_t, index_t, store, id_t, jerry_l, jerry_p, min_j);
     printf("Rick thank you for using our daycare service ! Your Jerry awaits ! \n");
 }
 
-void option_7(MultiValueHashTable phys_t, linked_list jerry_l, Planet** p_arr, int planet_num , char* buffer) {
+void option_7(MultiValueHashTable phys_t, hashTable index_t, jerry_store store, intrusive_list jerry_l, indexed_list jerry_p, Planet** p_arr, int planet_num , char* buffer) {
     /**
      * @brief Displays information about Jerries or planets based on user input.
      *
      * This function provides the user with options to display all Jerries, Jerries by a specific
-     * physical characteristic, or all known planets in the daycare system. The user selects an
-     * option, and the function retrieves and displays the corresponding data.
+     * physical characteristic, or all known planets in the daycare system. Jerries can also be
+     * selected by the value of a physical characteristic: those within a range of values, or
+     * those with the highest or lowest values, or by which characteristics they have and have
+     * not (see `find_jerries_by_phys_combination`). The saddest Jerries can be listed as well
+     * (see `find_saddest_jerries`), and the Jerries can be paged through in the order of their
+     * IDs: the first Jerry of a page is reached by its rank in O(log n) steps, so a page costs its
+     * own size. The user selects an option, and the function retrieves and displays the
+     * corresponding data.
      *
      * @param phys_t Pointer to the multi-value hash table for physical characteristics.
-     * @param jerry_l Pointer to the linked list of Jerries.
+     * @param index_t Pointer to the hash table of the indexes of the physical characteristics.
+     * @param store Pointer to the store holding the columns of the Jerries.
+     * @param jerry_l Pointer to the intrusive list of Jerries.
+     * @param jerry_p Pointer to the indexed list of the same Jerries, ordered by ID.
      * @param p_arr Pointer to the array of planets.
      * @param planet_num The number of planets in the array.
      * @param buffer A temporary buffer for user input.
@@ -975,10 +1226,16 @@ void option_7(MultiValueHashTable phys_t, linked_list jerry_l, Planet** p_arr, i
     printf("What information do you want to know ? \n"
            "1 : All Jerries \n"
            "2 : All Jerries by physical characteristics \n"
-           "3 : All known planets \n");
+           "3 : All known planets \n"
+           "4 : All Jerries by a range of physical characteristic values \n"
+           "5 : The Jerries with the highest physical characteristic values \n"
+           "6 : The Jerries with the lowest physical characteristic values \n"
+           "7 : All Jerries by a combination of physical characteristics \n"
+           "8 : The saddest Jerries \n"
+           "9 : A page of all Jerries \n");
     scanf("%s", buffer);
     int user_choise;
-    if (strcmp(buffer, "1") == 0 || strcmp(buffer, "2") == 0 || strcmp(buffer, "3") == 0) {
+    if (strlen(buffer) == 1 && buffer[0] >= '1' && buffer[0] <= '9') {
         user_choise = atoi(buffer);
     }
     else {
@@ -986,22 +1243,22 @@ void option_7(MultiValueHashTable phys_t, linked_list jerry_l, Planet** p_arr, i
     }
     switch (user_choise) {
         case 1:
-            if (getLengthList(jerry_l) == 0) {
+            if (getLengthIntrusiveList(jerry_l) == 0) {
                 printf("Rick we can not help you - we currently have no Jerries in the daycare ! \n");
                 return;
             }
-            displayList(jerry_l);
+            displayIntrusiveList(jerry_l);
             return;
         case 2:
             printf("What physical characteristics ? \n");
             scanf("%s", buffer);
-            Element elem =  lookupInMultiValueHashTable(phys_t, buffer);
+            Element elem =  lookupInMultiValueHashTable(phys_t, findName(buffer));
             if (elem == NULL) {
                 printf("Rick we can not help you - we do not know any Jerry's %s ! \n", buffer);
                 return;
             }
             printf("%s : \n", buffer);
-            list_forEach(elem, jerry_l) {
+            intrusive_forEach(elem, jerry_l) {
                 Jerry* j = (Jerry*) elem;
                 if (physExcit(j, buffer) == true) {
                     printJerry(j);
@@ -1013,26 +1270,211 @@ void option_7(MultiValueHashTable phys_t, linked_list jerry_l, Planet** p_arr, i
                 printPlanet(p_arr[i]);
             }
             return;
+        case 4:
+        case 5:
+        case 6:
+            printf("What physical characteristics ? \n");
+            scanf("%s", buffer);
+            phys_index* index = (phys_index*) borrowFromHashTable(index_t, findName(buffer));
+            if (index == NULL) {
+                printf("Rick we can not help you - we do not know any Jerry's %s ! \n", buffer);
+                return;
+            }
+            //the Jerries are printed straight from the ordered index, without collecting them first
+            ordered_range range;
+            if (user_choise == 4) {
+                float low, high;
+                printf("What is the lowest value of his %s ? \n", buffer);
+                if (scanf("%f", &low) != 1) {
+                    scanf("%*s");
+                    printf("Rick this option is not known to the daycare ! \n");
+                    return;
+                }
+                printf("What is the highest value of his %s ? \n", buffer);
+                if (scanf("%f", &high) != 1) {
+                    scanf("%*s");
+                    printf("Rick this option is not known to the daycare ! \n");
+                    return;
+                }
+                range = rangeOfOrderedIndex(index->byValue, low, high);
+            }
+            else {
+                int count;
+                printf("How many Jerries do you want to see ? \n");
+                if (scanf("%d", &count) != 1) {
+                    scanf("%*s");
+                    printf("Rick this option is not known to the daycare ! \n");
+                    return;
+                }
+                range = user_choise == 5 ? largestOfOrderedIndex(index->byValue, count)
+                    : smallestOfOrderedIndex(index->byValue, count);
+            }
+            printf("%s : \n", buffer);
+            ordered_forEach(elem, range) {
+                printJerry((Jerry*) elem);
+            }
+            return;
+        case 7:
+            find_jerries_by_phys_combination(index_t, store, buffer);
+            return;
+        case 8:
+            find_saddest_jerries(store);
+            return;
+        case 9:
+            if (getLengthIndexedList(jerry_p) == 0) {
+                printf("Rick we can not help you - we currently have no Jerries in the daycare ! \n");
+                return;
+            }
+            int page, page_size;
+            printf("What page do you want to see ? \n");
+            if (scanf("%d", &page) != 1) {
+                scanf("%*s");
+                printf("Rick this option is not known to the daycare ! \n");
+                return;
+            }
+            printf("How many Jerries do you want to see on a page ? \n");
+            if (scanf("%d", &page_size) != 1) {
+                scanf("%*s");
+                printf("Rick this option is not known to the daycare ! \n");
+                return;
+            }
+            if (page <= 0 || page_size <= 0) {
+                printf("Rick this option is not known to the daycare ! \n");
+                return;
+            }
+            int jerry_num = getLengthIndexedList(jerry_p);
+            int page_num = (int) ((jerry_num + (long) page_size - 1) / page_size);
+            if (page > page_num) {
+                printf("Rick we can not help you - there are only %d pages of Jerries ! \n", page_num);
+                return;
+            }
+            printf("Page %d of %d : \n", page, page_num);
+            range_forEach(elem, jerry_p, (page - 1) * page_size, page_size) {
+                printJerry((Jerry*) elem);
+            }
+            return;
         default:
             printf("Rick this option is not known to the daycare ! \n");
     }
 }
 
-void option_8(linked_list jerry_l, char* buffer) {
+void find_jerries_by_phys_combination(hashTable index_t, jerry_store store, char* buffer) {
+    /**
+     * @brief Displays the Jerries matching a combination of physical characteristics.
+     *
+     * The user names a first physical characteristic, then combines further ones with it: Jerries
+     * that also have the next one (and), that have either (or), or that do not have it (and not).
+     * The combinations apply from left to right on the bitmaps of Jerry ordinals kept by every
+     * characteristic, a whole container of ordinals at a time, so no list of Jerries is walked.
+     * The number of matching Jerries is printed, then the Jerries themselves by ordinal.
+     *
+     * @param index_t Pointer to the hash table of the indexes of the physical characteristics.
+     * @param store Pointer to the store holding the columns of the Jerries.
+     * @param buffer A temporary buffer for user input.
+     *
+     * @return Void. The function sets `memoryProb` to `true` if memory allocation fails.
+     */
+    printf("What physical characteristics ? \n");
+    scanf("%s", buffer);
+    phys_index* index = (phys_index*) borrowFromHashTable(index_t, findName(buffer));
+    //a characteristic no Jerry has stands for an empty set of ordinals
+    bitmap result = index != NULL ? copyBitmap(index->members) : createBitmap();
+    if (result == NULL) {
+        memoryProb = true;
+        return;
+    }
+    while (true) {
+        printf("What else do you remember ? \n"
+               "1 : He also has another physical characteristic \n"
+               "2 : Or he has another physical characteristic \n"
+               "3 : But he does not have another physical characteristic \n"
+               "4 : That is all \n");
+        if (scanf("%s", buffer) != 1 || strcmp(buffer, "4") == 0) break;
+        if (strcmp(buffer, "1") != 0 && strcmp(buffer, "2") != 0 && strcmp(buffer, "3") != 0) {
+            printf("Rick this option is not known to the daycare ! \n");
+            continue;
+        }
+        int combination = atoi(buffer);
+        printf("What physical characteristics ? \n");
+        scanf("%s", buffer);
+        index = (phys_index*) borrowFromHashTable(index_t, findName(buffer));
+        if (index == NULL) {
+            //no Jerry has it, so only requiring it changes the result: it leaves nobody
+            if (combination == 1) andNotBitmap(result, result);
+            continue;
+        }
+        status res = combination == 1 ? andBitmap(result, index->members)
+            : combination == 2 ? orBitmap(result, index->members) : andNotBitmap(result, index->members);
+        if (res == failure) {
+            memoryProb = true;
+            destroyBitmap(result);
+            return;
+        }
+    }
+    printf("Rick we found %d matching Jerries : \n", getCardinalityBitmap(result));
+    uint32_t ordinal;
+    bitmap_forEach(ordinal, result) {
+        printJerry(getJerryByOrdinal(store, ordinal));
+    }
+    destroyBitmap(result);
+}
+
+void find_saddest_jerries(jerry_store store) {
+    /**
+     * @brief Displays the Jerries with the lowest happiness levels, saddest first.
+     *
+     * The user chooses how many Jerries to see. They are read from the bucket queue of the store
+     * (see `findSaddestJerries`), so the cost depends on their number rather than on the number
+     * of Jerries in the daycare. Jerries as sad as each other are shown in the order they arrived.
+     *
+     * @param store Pointer to the store holding the columns of the Jerries.
+     *
+     * @return Void. The function sets `memoryProb` to `true` if memory allocation fails.
+     */
+    if (getJerryStoreSize(store) == 0) {
+        printf("Rick we can not help you - we currently have no Jerries in the daycare ! \n");
+        return;
+    }
+    int count;
+    printf("How many Jerries do you want to see ? \n");
+    if (scanf("%d", &count) != 1) {
+        scanf("%*s");
+        count = 0;
+    }
+    if (count <= 0) {
+        printf("Rick this option is not known to the daycare ! \n");
+        return;
+    }
+    if (count > getJerryStoreSize(store)) count = getJerryStoreSize(store);
+    Jerry** saddest = (Jerry**) malloc(count * sizeof(Jerry*));
+    if (saddest == NULL) {
+        memoryProb = true;
+        return;
+    }
+    int found = findSaddestJerries(store, saddest, count);
+    printf("Rick these are the saddest Jerries we found : \n");
+    for (int i=0; i < found; i++) {
+        printJerry(saddest[i]);
+    }
+    free(saddest);
+}
+
+void option_8(jerry_store store, intrusive_list jerry_l, char* buffer) {
     /**
      * @brief Initiates an activity for all Jerries in the daycare.
      *
      * This function allows the user to select an activity for all Jerries in the daycare.
      * Based on the activity chosen, the happiness levels of Jerries are adjusted accordingly.
      *
-     * @param jerry_l Pointer to the linked list of Jerries.
+     * @param store Pointer to the store holding the columns of the Jerries.
+     * @param jerry_l Pointer to the intrusive list of Jerries.
      * @param buffer A temporary buffer for user input.
      *
      * @return Void. The function adjusts happiness levels or prints a message for invalid input.
      *
      * @note If no Jerries are in the daycare, the function prints an appropriate message and exits.
      */
-    if (getLengthList(jerry_l) == 0) {
+    if (getLengthIntrusiveList(jerry_l) == 0) {
         printf("Rick we can not help you - we currently have no Jerries in the daycare ! \n");
         return;
     }
@@ -1051,13 +1493,13 @@ void option_8(linked_list jerry_l, char* buffer) {
     Element elem;
     switch (user_choise) {
         case 1:
-            adjust_happiness(jerry_l, 20, 5, 15);
+            adjust_happiness(store, jerry_l, 20, 5, 15);
             return;
         case 2:
-            adjust_happiness(jerry_l, 50, 10, 10);
+            adjust_happiness(store, jerry_l, 50, 10, 10);
             return;
         case 3:
-            adjust_happiness(jerry_l, 0, 0, 20);
+            adjust_happiness(store, jerry_l, 0, 0, 20);
             return;
         default:
             printf("Rick this option is not known to the daycare ! \n");
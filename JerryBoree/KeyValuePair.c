@@ -1,8 +1,6 @@
 #include "KeyValuePair.h"
 
-struct key_value_pair_rec {
-    Element key;
-    Element value;
+struct key_value_type_rec {
     EqualFunction key_comp;
     PrintFunction key_print;
     PrintFunction val_print;
@@ -10,52 +8,125 @@ struct key_value_pair_rec {
     FreeFunction val_free;
     CopyFunction key_copy;
     CopyFunction val_copy;
+    const allocator *alloc;
 };
 
+struct key_value_pair_rec {
+    Element key;
+    Element value;
+    uint64_t hash;
+    key_value_type type;
+};
+
+/**
+ * @brief A key-value pair created by `createKeyValuePair`, allocated together with its own
+ * type descriptor so that it can be released with a single `free`.
+ */
+typedef struct {
+    struct key_value_pair_rec pair;
+    struct key_value_type_rec type;
+} standalone_pair;
+
+key_value_type createKeyValueType(EqualFunction key_comp, PrintFunction key_print, PrintFunction val_print,
+    FreeFunction key_free, FreeFunction val_free, CopyFunction key_copy, CopyFunction val_copy,
+    const allocator *alloc) {
+    key_value_type type = malloc(sizeof(struct key_value_type_rec));
+    if (type == NULL) return NULL;
+    type->key_comp = key_comp;
+    type->key_print = key_print;
+    type->val_print = val_print;
+    type->key_free = key_free;
+    type->val_free = val_free;
+    type->key_copy = key_copy;
+    type->val_copy = val_copy;
+    type->alloc = alloc;
+    return type;
+}
+
+void destroyKeyValueType(key_value_type type) {
+    free(type);
+}
+
+key_value_pair createKeyValuePairOfType(Element key, Element value, key_value_type type) {
+    if (type == NULL) return NULL;
+    key_value_pair kv = allocateBlock(type->alloc, sizeof(struct key_value_pair_rec));
+    if (kv == NULL) return NULL;
+    kv->type = type;
+    kv->key = type->key_copy(key);
+    kv->value = type->val_copy(value);
+    kv->hash = 0;
+    return kv;
+}
+
+key_value_pair createKeyOnlyPairOfType(Element key, key_value_type type) {
+    if (type == NULL) return NULL;
+    key_value_pair kv = allocateBlock(type->alloc, sizeof(struct key_value_pair_rec));
+    if (kv == NULL) return NULL;
+    kv->type = type;
+    kv->key = type->key_copy(key);
+    kv->value = NULL;
+    kv->hash = 0;
+    return kv;
+}
+
 key_value_pair createKeyValuePair(Element key, Element value, EqualFunction key_comp, PrintFunction key_print,
     PrintFunction val_print, FreeFunction key_free, FreeFunction val_free,
     CopyFunction key_copy, CopyFunction val_copy) {
-    key_value_pair kv = malloc(sizeof(struct key_value_pair_rec));
-    if (kv == NULL) return NULL;
+    standalone_pair *sp = malloc(sizeof(standalone_pair));
+    if (sp == NULL) return NULL;
+    sp->type.key_comp = key_comp;
+    sp->type.key_print = key_print;
+    sp->type.val_print = val_print;
+    sp->type.key_free = key_free;
+    sp->type.val_free = val_free;
+    sp->type.key_copy = key_copy;
+    sp->type.val_copy = val_copy;
+    sp->type.alloc = NULL;
+    key_value_pair kv = &sp->pair;
+    kv->type = &sp->type;
     kv->key = key_copy(key);
     kv->value = val_copy(value);
-    kv->key_comp = key_comp;
-    kv->key_print = key_print;
-    kv->val_print = val_print;
-    kv->key_free = key_free;
-    kv->val_free = val_free;
-    kv->key_copy = key_copy;
-    kv->val_copy = val_copy;
+    kv->hash = 0;
     return kv;
 }
 
 void destroyKeyValuePair(key_value_pair kvp) {
     if (kvp == NULL) return;
-    kvp->key_free(kvp->key);
-    kvp->val_free(kvp->value);
-    free(kvp);
+    if (kvp->key != NULL) kvp->type->key_free(kvp->key);
+    if (kvp->value != NULL) kvp->type->val_free(kvp->value);
+    //standalone pairs carry a type without allocator, so they go back to free as one block
+    releaseBlock(kvp->type->alloc, kvp, sizeof(struct key_value_pair_rec));
+}
+
+size_t getKeyValuePairSize(void) {
+    return sizeof(struct key_value_pair_rec);
 }
 
 status displayValue(key_value_pair kvp) {
     if (kvp == NULL) return failure;
-    kvp->val_print(kvp->value);
+    kvp->type->val_print(kvp->value);
     return success;
 }
 
 status displayKey(key_value_pair kvp) {
     if (kvp == NULL) return failure;
-    kvp->key_print(kvp->key);
+    kvp->type->key_print(kvp->key);
     return success;
 }
 
 Element getValue(key_value_pair kvp) {
     if (kvp == NULL) return NULL;
-    return kvp->val_copy(kvp->value);
+    return kvp->type->val_copy(kvp->value);
+}
+
+Element *getValueSlot(key_value_pair kvp) {
+    if (kvp == NULL) return NULL;
+    return &kvp->value;
 }
 
 Element getKey(key_value_pair kvp) {
     if (kvp == NULL) return NULL;
-    return kvp->key_copy(kvp->key);
+    return kvp->type->key_copy(kvp->key);
 }
 
 Element get_shallow_key(key_value_pair kvp) {
@@ -65,7 +136,17 @@ Element get_shallow_key(key_value_pair kvp) {
 
 bool isEqualKey(key_value_pair kvp_1, key_value_pair kvp_2) {
     if (kvp_1 == NULL || kvp_2 == NULL) return false;
-    if ((kvp_1->key_comp(kvp_1->key, kvp_2->key) == true) ||
-        kvp_2->key_comp(kvp_1->key, kvp_2->key) == true) return true;
+    if ((kvp_1->type->key_comp(kvp_1->key, kvp_2->key) == true) ||
+        kvp_2->type->key_comp(kvp_1->key, kvp_2->key) == true) return true;
     return false;
-}
\ No newline at end of file
+}
+
+void setKeyHash(key_value_pair kvp, uint64_t hash) {
+    if (kvp == NULL) return;
+    kvp->hash = hash;
+}
+
+uint64_t getKeyHash(key_value_pair kvp) {
+    if (kvp == NULL) return 0;
+    return kvp->hash;
+}
@@ -1,14 +1,80 @@
 #ifndef KEY_VALUE_PAIR_H
 #define KEY_VALUE_PAIR_H
 #include "Defs.h"
+#include "Allocator.h"
 
 typedef struct key_value_pair_rec* key_value_pair;
+typedef struct key_value_type_rec* key_value_type;
+/**
+ * @brief Creates a type descriptor holding the utility functions of a family of key-value pairs.
+ *
+ * A container that stores many key-value pairs with the same behaviour creates one type
+ * descriptor and passes it to `createKeyValuePairOfType`. Every pair then keeps a single
+ * pointer to the shared descriptor instead of its own copy of the seven function pointers.
+ * The descriptor is immutable and must outlive all pairs created with it. The pairs of the
+ * type are allocated from `alloc`.
+ *
+ * @param key_comp Function pointer for comparing keys.
+ * @param key_print Function pointer for printing the key.
+ * @param val_print Function pointer for printing the value.
+ * @param key_free Function pointer for freeing the memory of the key.
+ * @param val_free Function pointer for freeing the memory of the value.
+ * @param key_copy Function pointer for creating a deep copy of the key.
+ * @param val_copy Function pointer for creating a deep copy of the value.
+ * @param alloc The allocator of the pairs (`NULL` for `malloc`). It must outlive the pairs.
+ *
+ * @return
+ * - Pointer to the newly created type descriptor if memory allocation is successful.
+ * - `NULL` if memory allocation fails.
+ */
+key_value_type createKeyValueType(EqualFunction key_comp, PrintFunction key_print, PrintFunction val_print,
+    FreeFunction key_free, FreeFunction val_free, CopyFunction key_copy, CopyFunction val_copy,
+    const allocator *alloc);
+/**
+ * @brief Frees a type descriptor created by `createKeyValueType`.
+ *
+ * @param type Pointer to the type descriptor. No pair of this type may be used afterwards.
+ *
+ * @return Void. The function performs no operation if the type descriptor is `NULL`.
+ */
+void destroyKeyValueType(key_value_type type);
+/**
+ * @brief Creates a key-value pair whose behaviour is defined by a shared type descriptor.
+ *
+ * This function allocates memory for a key-value pair structure and copies the provided
+ * key and value using the copy functions of the type descriptor.
+ *
+ * @param key The key element to be stored in the key-value pair.
+ * @param value The value element to be stored in the key-value pair.
+ * @param type The type descriptor shared by the pair (see `createKeyValueType`).
+ *
+ * @return
+ * - Pointer to the newly created key-value pair if memory allocation is successful.
+ * - `NULL` if the type descriptor is `NULL` or memory allocation fails.
+ */
+key_value_pair createKeyValuePairOfType(Element key, Element value, key_value_type type);
+/**
+ * @brief Creates a key-value pair that holds a copy of the key and no value yet.
+ *
+ * Containers that insert a key before they know its value use this function and store the
+ * value later through `getValueSlot`, which saves copying a value that is about to be replaced.
+ *
+ * @param key The key element to be stored in the key-value pair.
+ * @param type The type descriptor shared by the pair (see `createKeyValueType`).
+ *
+ * @return
+ * - Pointer to the newly created key-value pair, whose value is `NULL`, if memory allocation is successful.
+ * - `NULL` if the type descriptor is `NULL` or memory allocation fails.
+ */
+key_value_pair createKeyOnlyPairOfType(Element key, key_value_type type);
 /**
  * @brief Creates a key-value pair with specified utility functions.
  *
  * This function allocates memory for a key-value pair structure, copies the provided
  * key and value using their respective copy functions, and initializes the utility
- * functions for operations on the key and value.
+ * functions for operations on the key and value. The functions are kept in a private type
+ * descriptor allocated together with the pair; containers holding many pairs should prefer
+ * `createKeyValuePairOfType`.
  *
  * @param key The key element to be stored in the key-value pair.
  * @param value The value element to be stored in the key-value pair.
@@ -31,7 +97,8 @@ key_value_pair createKeyValuePair(Element key, Element value, EqualFunction key_
  *
  * This function deallocates the memory of both the key and the value stored
  * in the key-value pair using their respective free functions, and then
- * frees the memory allocated for the key-value pair structure itself.
+ * frees the memory allocated for the key-value pair structure itself. A `NULL` key or value
+ * is not passed to its free function.
  *
  * @param kvp Pointer to the key-value pair to be destroyed.
  *
@@ -92,6 +159,19 @@ status displayKey(key_value_pair kvp);
  * - `NULL` if the key-value pair is `NULL`.
  */
 Element getValue(key_value_pair kvp);
+/**
+ * @brief Retrieves the address of the value stored in a key-value pair.
+ *
+ * The value can be read or replaced through the returned pointer without copying it.
+ * Replacing it does not free the old value.
+ *
+ * @param kvp Pointer to the key-value pair.
+ *
+ * @return
+ * - The address of the value stored in the key-value pair.
+ * - `NULL` if the key-value pair is `NULL`.
+ */
+Element *getValueSlot(key_value_pair kvp);
 /**
  * @brief Retrieves copy of the key stored in a key-value pair.
  *
@@ -120,5 +200,37 @@ Element getKey(key_value_pair kvp);
  * - `false` if the keys are not equal or either key-value pair is `NULL`.
  */
 bool isEqualKey(key_value_pair kvp_1, key_value_pair kvp_2);
+/**
+ * @brief Stores the hash of the key in a key-value pair.
+ *
+ * Containers that hash their keys keep the hash in the pair, so they can reject
+ * non matching pairs without comparing keys and never hash a stored key twice.
+ * A new key-value pair has a hash of 0.
+ *
+ * @param kvp Pointer to the key-value pair.
+ * @param hash The hash of the pair's key.
+ *
+ * @return Void. The function performs no operation if the key-value pair is `NULL`.
+ */
+void setKeyHash(key_value_pair kvp, uint64_t hash);
+/**
+ * @brief Retrieves the hash of the key stored in a key-value pair.
+ *
+ * @param kvp Pointer to the key-value pair.
+ *
+ * @return
+ * - The hash stored with `setKeyHash`.
+ * - `0` if the key-value pair is `NULL`.
+ */
+uint64_t getKeyHash(key_value_pair kvp);
+
+/**
+ * @brief Retrieves the size of the memory block holding a pair created from a type descriptor.
+ *
+ * Lets a container size a slab pool (see `createSlabPool`) for its pairs.
+ *
+ * @return The size of a pair in bytes.
+ */
+size_t getKeyValuePairSize(void);
 
 #endif
\ No newline at end of file
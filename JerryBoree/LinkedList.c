@@ -1,22 +1,7 @@
 #include "LinkedList.h"
 
-typedef struct node_rec{
-    /**
- * @brief Structure representing a node in a doubly linked list.
- *
- * This structure defines a single node in a doubly linked list, containing:
- * - `data`: The element stored in the node.
- * - `next`: A pointer to the next node in the list.
- * - `prev`: A pointer to the previous node in the list.
- *
- * The typedef provides two aliases:
- * - `node_rec`: Represents the structure definition.
- * - `node`: Represents a pointer to a `node_rec`.
- */
-    Element data;
-    struct node_rec* next;
-    struct node_rec* prev;
-}node_rec, *node;
+typedef node_rec *node;
+typedef chunk_rec *chunk;
 
 struct linked_list_rec {
     /**
@@ -24,6 +9,7 @@ struct linked_list_rec {
  *
  * This structure defines a linked list, which includes:
  * - `head`: Pointer to the first node in the list.
+ * - `tail`: Pointer to the last node in the list, so appending does not walk the list.
  * - `current`: Pointer used for iteration within the list.
  * - `listLength`: The number of nodes in the list.
  * - `CopyFunction`: Function pointer for creating a deep copy of an element.
@@ -31,8 +17,13 @@ struct linked_list_rec {
  * - `PrintFunction`: Function pointer for printing an element.
  * - `EqualFunction`: Function pointer for checking equality between two elements.
  * - `getKeyFunction`: Function pointer for extracting a key from an element.
+ * - `alloc`: The allocator of the list, its nodes and chunks (`NULL` for `malloc`).
+ * - `unrolled`: Whether the elements are stored in chunks instead of nodes. An unrolled list
+ *   uses `firstChunk`, `lastChunk`, and iterates with `currentChunk` and `currentIndex`
+ *   (the position of the element last returned), leaving the node fields unused.
  */
     node head;
+    node tail;
     node current;
     int listLength;
     Element(*CopyFunction) (Element);
@@ -40,6 +31,29 @@ struct linked_list_rec {
     status(*PrintFunction) (Element);
     bool(*EqualFunction) (Element, Element);
     Element (*getKeyFunction) (Element);
+    const allocator *alloc;
+    bool unrolled;
+    chunk firstChunk;
+    chunk lastChunk;
+    chunk currentChunk;
+    int currentIndex;
+};
+
+struct intrusive_list_rec {
+    /**
+ * @brief Structure representing an intrusive list.
+ *
+ * The elements form a circular chain through their embedded links, closed by the `sentinel`
+ * link of the list itself, so linking and unlinking never test for the ends of the list.
+ * - `current`: The link of the element last returned by the iterator.
+ * - `linkOffset`: The offset of the link inside the elements.
+ */
+    list_link sentinel;
+    list_link *current;
+    size_t linkOffset;
+    int listLength;
+    status(*PrintFunction) (Element);
+    status(*FreeFunction) (Element);
 };
 
 
@@ -61,7 +75,7 @@ node createNode(Element elem, node prev,linked_list list) {
  * - Pointer to the newly created node if memory allocation is successful.
  * - `NULL` if memory allocation fails.
  */
-    node newNode = (node) malloc(sizeof(node_rec));
+    node newNode = (node) allocateBlock(list->alloc, sizeof(node_rec));
     if (newNode == NULL) {
         return NULL;
     }
@@ -73,10 +87,17 @@ node createNode(Element elem, node prev,linked_list list) {
 
 linked_list createLinkedList(CopyFunction copy, EqualFunction equal, PrintFunction print, FreeFunction elem_free,
      getKeyFunction getKey) {
-    linked_list newList = (linked_list) malloc(sizeof(struct linked_list_rec));
+    return createLinkedListWithAllocator(copy, equal, print, elem_free, getKey, NULL);
+}
+
+linked_list createLinkedListWithAllocator(CopyFunction copy, EqualFunction equal, PrintFunction print,
+     FreeFunction elem_free, getKeyFunction getKey, const allocator *alloc) {
+    linked_list newList = (linked_list) allocateBlock(alloc, sizeof(struct linked_list_rec));
     if (newList == NULL)
         return NULL;
+    newList->alloc = alloc;
     newList->head = NULL;
+    newList->tail = NULL;
     newList->current = NULL;
     newList->listLength = 0;
     newList->CopyFunction = copy;
@@ -84,59 +105,365 @@ linked_list createLinkedList(CopyFunction copy, EqualFunction equal, PrintFuncti
     newList -> PrintFunction = print;
     newList -> FreeFunction = elem_free;
     newList -> getKeyFunction = getKey;
+    newList->unrolled = false;
+    newList->firstChunk = NULL;
+    newList->lastChunk = NULL;
+    newList->currentChunk = NULL;
+    newList->currentIndex = -1;
     return newList;
 }
 
+linked_list createUnrolledLinkedList(CopyFunction copy, EqualFunction equal, PrintFunction print,
+     FreeFunction elem_free, getKeyFunction getKey) {
+    return createUnrolledLinkedListWithAllocator(copy, equal, print, elem_free, getKey, NULL);
+}
+
+linked_list createUnrolledLinkedListWithAllocator(CopyFunction copy, EqualFunction equal, PrintFunction print,
+     FreeFunction elem_free, getKeyFunction getKey, const allocator *alloc) {
+    linked_list newList = createLinkedListWithAllocator(copy, equal, print, elem_free, getKey, alloc);
+    if (newList == NULL)
+        return NULL;
+    newList->unrolled = true;
+    return newList;
+}
+
+static status push_item(linked_list list, Element data) {
+    /**
+ * @brief Stores an element, as is, after the last element of an unrolled list.
+ *
+ * @return `failure` if a new chunk is needed and can not be allocated, in which case the list is unchanged.
+ */
+    chunk last = list->lastChunk;
+    if (last == NULL || last->count == LIST_CHUNK_SIZE) {
+        chunk newChunk = (chunk) allocateBlock(list->alloc, sizeof(chunk_rec));
+        if (newChunk == NULL) return failure;
+        newChunk->count = 0;
+        newChunk->next = NULL;
+        newChunk->prev = last;
+        if (last == NULL) {
+            list->firstChunk = newChunk;
+        } else {
+            last->next = newChunk;
+        }
+        list->lastChunk = newChunk;
+        last = newChunk;
+    }
+    last->items[last->count++] = data;
+    list->listLength++;
+    return success;
+}
+
+static void free_chunk(linked_list list, chunk c) {
+    /**
+ * @brief Detaches a chunk from an unrolled list and frees it, without touching its elements.
+ */
+    if (c->prev == NULL) {
+        list->firstChunk = c->next;
+    } else {
+        c->prev->next = c->next;
+    }
+    if (c->next == NULL) {
+        list->lastChunk = c->prev;
+    } else {
+        c->next->prev = c->prev;
+    }
+    releaseBlock(list->alloc, c, sizeof(chunk_rec));
+}
+
+static void remove_item(linked_list list, chunk c, int i) {
+    /**
+ * @brief Removes the element at position `i` of a chunk without freeing it.
+ *
+ * The elements after it are shifted down so the chunk stays contiguous. A chunk that is left half
+ * empty absorbs the next chunk when both fit into one, so that chunks stay at least half full. The
+ * iterator is moved so that its next step lands on the element that followed the removed one.
+ */
+    memmove(&c->items[i], &c->items[i + 1], (c->count - i - 1) * sizeof(Element));
+    c->count--;
+    list->listLength--;
+    if (list->currentChunk == c && list->currentIndex >= i) list->currentIndex--;
+    if (c->count == 0) {
+        if (list->currentChunk == c) {
+            list->currentChunk = c->prev;
+            list->currentIndex = c->prev == NULL ? -1 : c->prev->count - 1;
+        }
+        free_chunk(list, c);
+        return;
+    }
+    chunk next = c->next;
+    if (c->count <= LIST_CHUNK_SIZE / 2 && next != NULL && c->count + next->count <= LIST_CHUNK_SIZE) {
+        memcpy(&c->items[c->count], next->items, next->count * sizeof(Element));
+        if (list->currentChunk == next) {
+            list->currentChunk = c;
+            list->currentIndex += c->count;
+        }
+        c->count += next->count;
+        free_chunk(list, next);
+    }
+}
+
+static bool find_item(linked_list list, Element key, chunk *found, int *index) {
+    /**
+ * @brief Finds the first element of an unrolled list whose key equals `key`.
+ */
+    for (chunk c = list->firstChunk; c != NULL; c = c->next) {
+        for (int i = 0; i < c->count; i++) {
+            if (list->EqualFunction(list->getKeyFunction(c->items[i]), key) == true) {
+                *found = c;
+                *index = i;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+list_node appendNodeHandle(linked_list list, Element elem) {
+    if (list == NULL || list->unrolled) return NULL;
+    node newNode = createNode(elem, list->tail, list);
+    if (newNode == NULL) return NULL;
+    if (list->listLength == 0) {
+        list->head = newNode;
+    } else {
+        list->tail->next = newNode;
+    }
+    list->tail = newNode;
+    list->listLength++;
+    return newNode;
+}
+
 status appendNode(linked_list list, Element elem) {
-    if (list == NULL) {
+    if (list == NULL) return failure;
+    if (list->unrolled) {
+        Element data = list->CopyFunction(elem);
+        if (push_item(list, data) == success) return success;
+        list->FreeFunction(data);
         return failure;
     }
-    if (list -> listLength == 0) {
-        node newNode = createNode(elem, NULL, list);
-        if (newNode == NULL) return failure;
-        list -> head = newNode;
-        list ->listLength++;
-        return success;
+    if (appendNodeHandle(list, elem) == NULL) return failure;
+    return success;
+}
+
+static void unlink_node(linked_list list, node cur) {
+    /**
+ * @brief Detaches a node from the list without freeing it.
+ */
+    if (cur->prev == NULL) {
+        list->head = cur->next;
+    } else {
+        cur->prev->next = cur->next;
+    }
+    if (cur->next == NULL) {
+        list->tail = cur->prev;
+    } else {
+        cur->next->prev = cur->prev;
+    }
+    if (list->current == cur) list->current = cur->prev;
+    list->listLength--;
+}
+
+status unlinkNode(linked_list list, list_node handle) {
+    if (list == NULL || handle == NULL || list->unrolled) return failure;
+    unlink_node(list, handle);
+    list->FreeFunction(handle->data);
+    releaseBlock(list->alloc, handle, sizeof(node_rec));
+    return success;
+}
+
+Element getNodeData(list_node handle) {
+    if (handle == NULL) return NULL;
+    return handle->data;
+}
+
+list_node getHeadNode(linked_list list) {
+    if (list == NULL || list->unrolled) return NULL;
+    return list->head;
+}
+
+list_node getNextNode(list_node handle) {
+    if (handle == NULL) return NULL;
+    return handle->next;
+}
+
+static status to_node_storage(linked_list list) {
+    /**
+ * @brief Moves the elements of an unrolled list into nodes. All the nodes are allocated first,
+ * so that a failed allocation leaves the list as it was.
+ */
+    node first = NULL;
+    for (int i = 0; i < list->listLength; i++) {
+        node n = (node) allocateBlock(list->alloc, sizeof(node_rec));
+        if (n == NULL) {
+            while (first != NULL) {
+                node next = first->next;
+                releaseBlock(list->alloc, first, sizeof(node_rec));
+                first = next;
+            }
+            return failure;
+        }
+        n->next = first;
+        first = n;
+    }
+    node prev = NULL;
+    node n = first;
+    chunk c = list->firstChunk;
+    while (c != NULL) {
+        for (int i = 0; i < c->count; i++) {
+            n->data = c->items[i];
+            n->prev = prev;
+            prev = n;
+            n = n->next;
+        }
+        chunk next = c->next;
+        releaseBlock(list->alloc, c, sizeof(chunk_rec));
+        c = next;
+    }
+    list->head = first;
+    list->tail = prev;
+    list->firstChunk = NULL;
+    list->lastChunk = NULL;
+    return success;
+}
+
+static status to_chunk_storage(linked_list list) {
+    /**
+ * @brief Moves the elements of a node list into full chunks. All the chunks are allocated first,
+ * so that a failed allocation leaves the list as it was.
+ */
+    chunk first = NULL;
+    chunk last = NULL;
+    for (int i = 0; i < list->listLength; i += LIST_CHUNK_SIZE) {
+        chunk c = (chunk) allocateBlock(list->alloc, sizeof(chunk_rec));
+        if (c == NULL) {
+            while (first != NULL) {
+                chunk next = first->next;
+                releaseBlock(list->alloc, first, sizeof(chunk_rec));
+                first = next;
+            }
+            return failure;
+        }
+        c->count = 0;
+        c->next = NULL;
+        c->prev = last;
+        if (last == NULL) first = c;
+        else last->next = c;
+        last = c;
     }
+    chunk c = first;
     node cur = list->head;
-    for (int i = 0; i < list->listLength-1; i++) {
-        cur = cur->next;
+    while (cur != NULL) {
+        if (c->count == LIST_CHUNK_SIZE) c = c->next;
+        c->items[c->count++] = cur->data;
+        node next = cur->next;
+        releaseBlock(list->alloc, cur, sizeof(node_rec));
+        cur = next;
     }
-    node newNode = createNode(elem, cur, list);
-    if (newNode == NULL) return failure;
-    cur->next = newNode;
-    list -> listLength++;
+    list->firstChunk = first;
+    list->lastChunk = last;
+    list->head = NULL;
+    list->tail = NULL;
+    return success;
+}
+
+status setListUnrolled(linked_list list, bool unrolled) {
+    if (list == NULL) return failure;
+    if (list->unrolled == unrolled) return success;
+    if ((unrolled ? to_chunk_storage(list) : to_node_storage(list)) == failure) return failure;
+    list->unrolled = unrolled;
+    list->current = NULL;
+    list->currentChunk = NULL;
+    list->currentIndex = -1;
     return success;
 }
 
 status deleteNode(linked_list list, Element elem) {
     if (list == NULL) return failure;
+    Element key = list->getKeyFunction(elem);
+    if (list->unrolled) {
+        chunk c;
+        int i;
+        if (find_item(list, key, &c, &i) == false) return failure;
+        Element data = c->items[i];
+        remove_item(list, c, i);
+        list->FreeFunction(data);
+        return success;
+    }
     node cur = list->head;
     for (int i = 0; i < list->listLength; i++) {
-        if (list->EqualFunction(list->getKeyFunction(cur->data) ,list->getKeyFunction(elem)) == true) {
-            if (i == 0) {
-                list->head = cur->next;
-                if (cur->next != NULL) {
-                    cur->next->prev = NULL;
-                }
-            }else if (i == list->listLength-1) {
-                cur->prev->next = NULL;
-            }else {
-                cur->prev->next = cur->next;
-                cur->next->prev = cur->prev;
-            }
-            list->FreeFunction(cur->data);
-            free(cur);
-            list -> listLength--;
-            return success;
+        if (list->EqualFunction(list->getKeyFunction(cur->data), key) == true) {
+            return unlinkNode(list, cur);
         }
         cur = cur->next;
     }
     return failure;
 }
 
+status transferHeadNode(linked_list from, linked_list to) {
+    if (from == NULL || to == NULL || from->listLength == 0) return failure;
+    //nodes only move between lists drawing from the same allocator
+    if (from->unrolled || to->unrolled || from->alloc != to->alloc) {
+        //the element is stored in its new place first, so a failed allocation leaves both lists unchanged
+        Element data = from->unrolled ? from->firstChunk->items[0] : from->head->data;
+        if (to->unrolled) {
+            if (push_item(to, data) == failure) return failure;
+        } else {
+            node moved = (node) allocateBlock(to->alloc, sizeof(node_rec));
+            if (moved == NULL) return failure;
+            moved->data = data;
+            moved->next = NULL;
+            moved->prev = to->tail;
+            if (to->listLength == 0) {
+                to->head = moved;
+            } else {
+                to->tail->next = moved;
+            }
+            to->tail = moved;
+            to->listLength++;
+        }
+        popHeadNode(from);
+        return success;
+    }
+    node moved = from->head;
+    unlink_node(from, moved);
+    moved->next = NULL;
+    moved->prev = to->tail;
+    if (to->listLength == 0) {
+        to->head = moved;
+    } else {
+        to->tail->next = moved;
+    }
+    to->tail = moved;
+    to->listLength++;
+    return success;
+}
+
+Element popHeadNode(linked_list list) {
+    if (list == NULL || list->listLength == 0) return NULL;
+    if (list->unrolled) {
+        Element data = list->firstChunk->items[0];
+        remove_item(list, list->firstChunk, 0);
+        return data;
+    }
+    node popped = list->head;
+    Element data = popped->data;
+    unlink_node(list, popped);
+    releaseBlock(list->alloc, popped, sizeof(node_rec));
+    return data;
+}
+
 Element getDataByIndex(linked_list list, int index) {
     if (list == NULL || list->listLength < index) return NULL;
+    if (list->unrolled) {
+        if (index < 1) return NULL;
+        //whole chunks are skipped by their counts
+        int skipped = index - 1;
+        chunk c = list->firstChunk;
+        while (skipped >= c->count) {
+            skipped -= c->count;
+            c = c->next;
+        }
+        return list->CopyFunction(c->items[skipped]);
+    }
     node cur = list->head;
     for (int i = 0; i < index; i++) {
         if (i == index - 1) return list->CopyFunction(cur->data);
@@ -151,11 +478,23 @@ int getLengthList(linked_list list) {
 }
 
 Element searchByKey(linked_list list, Element key) {
+    Element data = borrowByKey(list, key);
+    if (data == NULL) return NULL;
+    return list->CopyFunction(data);
+}
+
+Element borrowByKey(linked_list list, Element key) {
     if (list == NULL) return NULL;
+    if (list->unrolled) {
+        chunk c;
+        int i;
+        if (find_item(list, key, &c, &i) == false) return NULL;
+        return c->items[i];
+    }
     node cur = list->head;
     for (int i = 0; i < list->listLength; i++) {
         if (list->EqualFunction(list->getKeyFunction(cur->data), key) == true) {
-            return list->CopyFunction(cur->data);
+            return cur->data;
         }
         cur = cur->next;
     }
@@ -164,7 +503,21 @@ Element searchByKey(linked_list list, Element key) {
 
 Element listNext(linked_list list) {
     if (list == NULL) return NULL;
-    node cur = list->current->next;
+    if (list->unrolled) {
+        //currentChunk is NULL before the first element
+        chunk c = list->currentChunk == NULL ? list->firstChunk : list->currentChunk;
+        int i = list->currentChunk == NULL ? 0 : list->currentIndex + 1;
+        if (c != NULL && i >= c->count) {
+            c = c->next;
+            i = 0;
+        }
+        if (c == NULL) return NULL;
+        list->currentChunk = c;
+        list->currentIndex = i;
+        return c->items[i];
+    }
+    //current is NULL once the node it pointed to was removed from the head of the list
+    node cur = list->current == NULL ? list->head : list->current->next;
     if (cur == NULL) return NULL;
     list->current = cur;
     return cur->data;
@@ -172,12 +525,35 @@ Element listNext(linked_list list) {
 
 Element listHead(linked_list list) {
     if (list == NULL) return NULL;
+    if (list->unrolled) {
+        list->currentChunk = NULL;
+        list->currentIndex = -1;
+        return listNext(list);
+    }
     list->current = list->head;
+    if (list->head == NULL) return NULL;
     return list->head->data;
 }
 
+list_iterator listIterator(linked_list list) {
+    list_iterator it = { NULL, NULL, 0 };
+    if (list == NULL) return it;
+    if (list->unrolled) {
+        it.chunk = list->firstChunk;
+    } else {
+        it.nextNode = list->head;
+    }
+    return it;
+}
+
 status displayList(linked_list list) {
     if (list == NULL) return failure;
+    if (list->unrolled) {
+        for (chunk c = list->firstChunk; c != NULL; c = c->next) {
+            for (int i = 0; i < c->count; i++) list->PrintFunction(c->items[i]);
+        }
+        return success;
+    }
     node cur = list->head;
     for (int i = 0; i < list->listLength; i++) {
         list->PrintFunction(cur->data);
@@ -188,13 +564,128 @@ status displayList(linked_list list) {
 
 void destroyList(linked_list list) {
     if (list == NULL) return;
+    if (list->unrolled) {
+        chunk c = list->firstChunk;
+        while (c != NULL) {
+            for (int i = 0; i < c->count; i++) list->FreeFunction(c->items[i]);
+            chunk next = c->next;
+            releaseBlock(list->alloc, c, sizeof(chunk_rec));
+            c = next;
+        }
+        releaseBlock(list->alloc, list, sizeof(struct linked_list_rec));
+        return;
+    }
     node cur = list->head;
     for (int i = 0; i < list->listLength; i++) {
         list->FreeFunction(cur->data);
         node next = cur->next;
-        free(cur);
+        releaseBlock(list->alloc, cur, sizeof(node_rec));
         cur = next;
     }
-    free(list);
+    releaseBlock(list->alloc, list, sizeof(struct linked_list_rec));
+}
+
+static list_link *link_of(intrusive_list list, Element elem) {
+    return (list_link *) ((char *) elem + list->linkOffset);
+}
+
+static Element element_of(intrusive_list list, list_link *link) {
+    return (Element) ((char *) link - list->linkOffset);
+}
+
+intrusive_list createIntrusiveList(size_t linkOffset, PrintFunction print, FreeFunction elem_free) {
+    intrusive_list newList = (intrusive_list) malloc(sizeof(struct intrusive_list_rec));
+    if (newList == NULL)
+        return NULL;
+    newList->sentinel.prev = &newList->sentinel;
+    newList->sentinel.next = &newList->sentinel;
+    newList->current = &newList->sentinel;
+    newList->linkOffset = linkOffset;
+    newList->listLength = 0;
+    newList->PrintFunction = print;
+    newList->FreeFunction = elem_free;
+    return newList;
+}
+
+void initListLink(list_link *link) {
+    if (link == NULL) return;
+    link->prev = NULL;
+    link->next = NULL;
+}
+
+status linkElement(intrusive_list list, Element elem) {
+    if (list == NULL || elem == NULL) return failure;
+    list_link *link = link_of(list, elem);
+    if (link->next != NULL) return failure;
+    link->prev = list->sentinel.prev;
+    link->next = &list->sentinel;
+    list->sentinel.prev->next = link;
+    list->sentinel.prev = link;
+    list->listLength++;
+    return success;
+}
+
+status unlinkElement(intrusive_list list, Element elem) {
+    if (list == NULL || elem == NULL) return failure;
+    list_link *link = link_of(list, elem);
+    if (link->next == NULL) return failure;
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    //the iterator steps back so that its next step lands on the element that followed
+    if (list->current == link) list->current = link->prev;
+    initListLink(link);
+    list->listLength--;
+    return success;
+}
+
+status deleteElement(intrusive_list list, Element elem) {
+    if (unlinkElement(list, elem) == failure) return failure;
+    list->FreeFunction(elem);
+    return success;
+}
+
+int getLengthIntrusiveList(intrusive_list list) {
+    if (list == NULL) return 0;
+    return list->listLength;
 }
 
+Element intrusiveHead(intrusive_list list) {
+    if (list == NULL) return NULL;
+    list->current = &list->sentinel;
+    return intrusiveNext(list);
+}
+
+Element intrusiveNext(intrusive_list list) {
+    if (list == NULL || list->current->next == &list->sentinel) return NULL;
+    list->current = list->current->next;
+    return element_of(list, list->current);
+}
+
+intrusive_iterator intrusiveIterator(intrusive_list list) {
+    intrusive_iterator it = { NULL, NULL, 0 };
+    if (list == NULL) return it;
+    it.nextLink = list->sentinel.next;
+    it.end = &list->sentinel;
+    it.linkOffset = list->linkOffset;
+    return it;
+}
+
+status displayIntrusiveList(intrusive_list list) {
+    if (list == NULL) return failure;
+    for (list_link *link = list->sentinel.next; link != &list->sentinel; link = link->next) {
+        list->PrintFunction(element_of(list, link));
+    }
+    return success;
+}
+
+void destroyIntrusiveList(intrusive_list list) {
+    if (list == NULL) return;
+    list_link *link = list->sentinel.next;
+    while (link != &list->sentinel) {
+        list_link *next = link->next;
+        initListLink(link);
+        list->FreeFunction(element_of(list, link));
+        link = next;
+    }
+    free(list);
+}
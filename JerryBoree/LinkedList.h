@@ -1,10 +1,92 @@
 #ifndef LINKED_LIST_H
 #define LINKED_LIST_H
 #include "Defs.h"
+#include <stddef.h>
+#include "Allocator.h"
 
 typedef struct linked_list_rec* linked_list;
 typedef Element (*getKeyFunction) (Element);
 
+/** The number of elements stored in one chunk of an unrolled list (16 pointers, two cache lines). */
+#define LIST_CHUNK_SIZE 16
+
+typedef struct node_rec{
+    /**
+ * @brief Structure representing a node in a doubly linked list.
+ *
+ * This structure defines a single node in a doubly linked list, containing:
+ * - `data`: The element stored in the node.
+ * - `next`: A pointer to the next node in the list.
+ * - `prev`: A pointer to the previous node in the list.
+ *
+ * The layout is public only so that `listIteratorNext` can be inlined; code outside
+ * LinkedList.c must not access the fields.
+ */
+    Element data;
+    struct node_rec* next;
+    struct node_rec* prev;
+}node_rec, *list_node;
+
+typedef struct chunk_rec {
+    /**
+ * @brief A chunk of an unrolled list: up to `LIST_CHUNK_SIZE` consecutive elements stored
+ * contiguously, so that a scan reads one cache line after another instead of chasing a
+ * pointer per element. The elements of a chunk are kept at the front of `items`.
+ *
+ * Like `node_rec`, the layout is public only for `listIteratorNext`.
+ */
+    struct chunk_rec* next;
+    struct chunk_rec* prev;
+    int count;
+    Element items[LIST_CHUNK_SIZE];
+}chunk_rec;
+typedef struct intrusive_list_rec* intrusive_list;
+
+/**
+ * @brief The links of an element in an intrusive list.
+ *
+ * An intrusive list does not allocate nodes: every element embeds a `list_link` and the list
+ * chains the elements through it. The list finds the link inside an element by the offset of the
+ * member (`offsetof(type, member)`), so one element may sit in several intrusive lists through
+ * several links. A link that is in no list has both pointers `NULL`.
+ */
+typedef struct list_link_rec {
+    struct list_link_rec *prev;
+    struct list_link_rec *next;
+} list_link;
+
+/**
+ * @brief A position in a linked list, kept by the caller (usually on the stack).
+ *
+ * Unlike `listHead`/`listNext`, which keep the position inside the list, every iterator holds
+ * its own position, so nested loops over the same list and several threads reading the same
+ * list do not disturb each other. An iterator only reads the list.
+ *
+ * Members (not to be accessed directly):
+ *   - nextNode: The node whose element is returned next (lists made by `createLinkedList`).
+ *   - chunk: The chunk being read (lists made by `createUnrolledLinkedList`).
+ *   - index: The position in `chunk` of the element returned next.
+ */
+typedef struct {
+    list_node nextNode;
+    chunk_rec *chunk;
+    int index;
+} list_iterator;
+
+/**
+ * @brief A position in an intrusive list, kept by the caller, in the manner of `list_iterator`.
+ *
+ * Members (not to be accessed directly):
+ *   - nextLink: The link of the element returned next.
+ *   - end: The sentinel link of the list, reached after the last element.
+ *   - linkOffset: The offset of the link inside the elements.
+ */
+typedef struct {
+    list_link *nextLink;
+    list_link *end;
+    size_t linkOffset;
+} intrusive_iterator;
+
 /**
  * @brief Creates a new linked list with specified utility functions.
  *
@@ -24,6 +106,56 @@ typedef Element (*getKeyFunction) (Element);
  */
 linked_list createLinkedList(CopyFunction copy, EqualFunction equal, PrintFunction print, FreeFunction elem_free,
      getKeyFunction getKey);
+/**
+ * @brief Creates a new unrolled linked list with specified utility functions.
+ *
+ * An unrolled list stores its elements in chunks of 16 contiguous element pointers instead of
+ * one node per element, so scans (`list_forEach`, `displayList`, `searchByKey`, `destroyList`)
+ * read memory sequentially. It offers the same functions and keeps the same order as a list made
+ * by `createLinkedList`, except that it has no node handles: `appendNodeHandle` returns `NULL`
+ * and `unlinkNode` fails on it.
+ *
+ * @param copy Function pointer for creating a deep copy of an element.
+ * @param equal Function pointer for comparing two elements for equality.
+ * @param print Function pointer for printing an element.
+ * @param elem_free Function pointer for freeing the memory of an element.
+ * @param getKey Function pointer for extracting a key from an element.
+ *
+ * @return
+ * - Pointer to the newly created linked list if memory allocation is successful.
+ * - `NULL` if memory allocation fails.
+ */
+linked_list createUnrolledLinkedList(CopyFunction copy, EqualFunction equal, PrintFunction print,
+     FreeFunction elem_free, getKeyFunction getKey);
+/**
+ * @brief Creates a new linked list whose structure, nodes and chunks come from an allocator.
+ *
+ * Works like `createLinkedList`; the elements themselves are still made by `copy`. Pairing the
+ * list with a slab pool (see `createSlabPool`) removes the `malloc` call of every append.
+ *
+ * @param copy Function pointer for creating a deep copy of an element.
+ * @param equal Function pointer for comparing two elements for equality.
+ * @param print Function pointer for printing an element.
+ * @param elem_free Function pointer for freeing the memory of an element.
+ * @param getKey Function pointer for extracting a key from an element.
+ * @param alloc The allocator of the list (`NULL` for `malloc`). It must outlive the list.
+ *
+ * @return
+ * - Pointer to the newly created linked list if memory allocation is successful.
+ * - `NULL` if memory allocation fails.
+ */
+linked_list createLinkedListWithAllocator(CopyFunction copy, EqualFunction equal, PrintFunction print,
+     FreeFunction elem_free, getKeyFunction getKey, const allocator *alloc);
+/**
+ * @brief Creates a new unrolled linked list (see `createUnrolledLinkedList`) whose structure and
+ * chunks come from an allocator (see `createLinkedListWithAllocator`).
+ *
+ * @return
+ * - Pointer to the newly created linked list if memory allocation is successful.
+ * - `NULL` if memory allocation fails.
+ */
+linked_list createUnrolledLinkedListWithAllocator(CopyFunction copy, EqualFunction equal, PrintFunction print,
+     FreeFunction elem_free, getKeyFunction getKey, const allocator *alloc);
 /**
  * @brief Appends a new node with the given element to the end of a linked list.
  *
@@ -55,6 +187,110 @@ status appendNode(linked_list list, Element elem);
  * - `failure` if the linked list is `NULL`, or no matching node is found.
  */
 status deleteNode(linked_list list, Element elem);
+/**
+ * @brief Appends a new element to the end of the linked list and returns its node.
+ *
+ * Works like `appendNode`, but returns a handle to the new node, which stays valid until the
+ * node is removed from the list. Holding the handle lets the element be removed with
+ * `unlinkNode` without searching for it. Both functions take constant time.
+ *
+ * @param list Pointer to the linked list.
+ * @param elem The element to be appended. The element is copied using the list's `CopyFunction`.
+ *
+ * @return
+ * - The handle of the new node.
+ * - `NULL` if the linked list is `NULL` or unrolled, or memory allocation fails.
+ */
+list_node appendNodeHandle(linked_list list, Element elem);
+/**
+ * @brief Removes the node of a handle from the linked list in constant time.
+ *
+ * The element is freed with the list's `FreeFunction`, exactly as `deleteNode` would, and the
+ * handle becomes invalid. The element may be removed while the list is being iterated.
+ *
+ * @param list Pointer to the linked list holding the node.
+ * @param handle The handle returned by `appendNodeHandle` when the element was added.
+ *
+ * @return
+ * - `success` if the node is removed.
+ * - `failure` if the linked list or the handle is `NULL`, or the list is unrolled.
+ */
+status unlinkNode(linked_list list, list_node handle);
+/**
+ * @brief Retrieves the element stored in a node without copying it.
+ *
+ * @param handle The handle of the node.
+ *
+ * @return
+ * - The element stored in the node.
+ * - `NULL` if the handle is `NULL`.
+ */
+Element getNodeData(list_node handle);
+/**
+ * @brief Retrieves the handle of the first node of a linked list.
+ *
+ * Together with `getNextNode`, lets the caller collect the handles of the elements already in a
+ * list, for example to index them.
+ *
+ * @param list Pointer to the linked list.
+ *
+ * @return
+ * - The handle of the first node.
+ * - `NULL` if the list is `NULL`, empty, or unrolled.
+ */
+list_node getHeadNode(linked_list list);
+/**
+ * @brief Retrieves the handle of the node following a node.
+ *
+ * @param handle The handle of a node.
+ *
+ * @return
+ * - The handle of the next node.
+ * - `NULL` if the handle is `NULL` or its node is the last one.
+ */
+list_node getNextNode(list_node handle);
+/**
+ * @brief Switches a linked list between node storage and unrolled (chunk) storage.
+ *
+ * The elements and their order are kept; the position of `listHead`/`listNext` is reset, and
+ * handles of the old nodes become invalid. Either all the new nodes or chunks are allocated
+ * or the list is left unchanged.
+ *
+ * @param list Pointer to the linked list.
+ * @param unrolled `true` for chunk storage (see `createUnrolledLinkedList`), `false` for node storage.
+ *
+ * @return
+ * - `success` if the list uses the requested storage.
+ * - `failure` if the list is `NULL` or memory allocation fails.
+ */
+status setListUnrolled(linked_list list, bool unrolled);
+/**
+ * @brief Moves the head node of one linked list to the end of another linked list.
+ *
+ * This function detaches the first node of `from` and links it as the last node of `to`.
+ * The node itself is reused, so its element is neither copied nor freed and no memory is
+ * allocated. Both lists are expected to manage elements the same way.
+ *
+ * @param from Pointer to the linked list whose head node is moved.
+ * @param to Pointer to the linked list that receives the node.
+ *
+ * @return
+ * - `success` if the node is moved.
+ * - `failure` if either linked list is `NULL` or `from` is empty.
+ */
+status transferHeadNode(linked_list from, linked_list to);
+/**
+ * @brief Removes the head node of the linked list and returns its element.
+ *
+ * The node is freed but the element is not: the caller takes it over.
+ *
+ * @param list Pointer to the linked list.
+ *
+ * @return
+ * - The element stored in the removed head node.
+ * - `NULL` if the linked list is `NULL` or empty.
+ */
+Element popHeadNode(linked_list list);
 /**
  * @brief Retrieves the data stored at a specified index in a linked list.
  *
@@ -97,6 +333,20 @@ int getLengthList(linked_list list);
  * - `NULL` if the linked list is `NULL` or no matching element is found.
  */
 Element searchByKey(linked_list list, Element key);
+/**
+ * @brief Searches for an element in the linked list by a specified key without copying it.
+ *
+ * Works like `searchByKey` but returns the element stored in the list itself. The element
+ * still belongs to the list and stays valid until it is deleted.
+ *
+ * @param list Pointer to the linked list.
+ * @param key The key to search for, compared using the list's `EqualFunction` and `getKeyFunction`.
+ *
+ * @return
+ * - The element that matches the provided key if found.
+ * - `NULL` if the linked list is `NULL` or no matching element is found.
+ */
+Element borrowByKey(linked_list list, Element key);
 /**
  * @brief Helper function for iterating through the linked list.
  *
@@ -118,11 +368,14 @@ Element listNext(linked_list list);
  * element stored in the head node. It is intended to be used as part of the linked list's
  * iterator functionality.
  *
+ * The position is stored in the list itself, so only one such iteration may run over a list at
+ * a time; `list_iterator` has no such limit.
+ *
  * @param list Pointer to the linked list.
  *
  * @return
  * - The element stored in the head node if the list is not `NULL`.
- * - `NULL` if the linked list is `NULL`.
+ * - `NULL` if the linked list is `NULL` or empty.
  */
 Element listHead(linked_list list);
 /**
@@ -155,20 +408,58 @@ status displayList(linked_list list);
  *   allocated memory associated with the list.
  */
 void destroyList(linked_list list);
+/**
+ * @brief Creates an iterator positioned before the first element of a linked list.
+ *
+ * @param list Pointer to the linked list. A `NULL` list gives an iterator with no elements.
+ *
+ * @return The iterator, to be advanced with `listIteratorNext`.
+ */
+list_iterator listIterator(linked_list list);
+/**
+ * @brief Advances an iterator and returns the element it passed over.
+ *
+ * The list must not be changed while the iterator is in use, except that the element just
+ * returned may be removed from a list made by `createLinkedList`: the iterator has already
+ * moved past its node. Removing elements from an unrolled list shifts the elements of a chunk
+ * and invalidates its iterators.
+ *
+ * @param it Pointer to the iterator.
+ *
+ * @return
+ * - The next element of the list.
+ * - `NULL` once all the elements were returned.
+ */
+static inline Element listIteratorNext(list_iterator *it) {
+    if (it->chunk != NULL) {
+        if (it->index == it->chunk->count) {
+            it->chunk = it->chunk->next;
+            it->index = 0;
+            if (it->chunk == NULL) return NULL;
+        }
+        return it->chunk->items[it->index++];
+    }
+    if (it->nextNode == NULL) return NULL;
+    Element data = it->nextNode->data;
+    it->nextNode = it->nextNode->next;
+    return data;
+}
 /**
  * @brief Macro for iterating through all elements in a linked list.
  *
- * This macro simplifies the iteration process over a linked list. It sets the iterator
- * to the head of the list and moves through each element using `listHead` and `listNext`
- * functions until the end of the list is reached.
+ * This macro simplifies the iteration process over a linked list. It declares a
+ * `list_iterator` local to the loop and moves through each element using `listIteratorNext`
+ * until the end of the list is reached.
  *
  * @param e The variable to hold the current element during the iteration.
  * @param l The linked list to iterate over.
  *
  * @note
- * - The macro assumes that the `listHead` and `listNext` functions are implemented correctly
- *   and handle edge cases such as an empty list or reaching the end of the list.
- * - The iteration stops when `listNext` returns `NULL`.
+ * - Loops over the same list may be nested, and several threads may loop over a list that
+ *   none of them changes.
+ * - The element of the current step may be removed only from lists made by `createLinkedList`
+ *   (see `listIteratorNext`).
+ * - The iteration stops when `listIteratorNext` returns `NULL`; an empty list runs no step.
  *
  * @example
  * Element elem;
@@ -178,6 +469,154 @@ void destroyList(linked_list list);
  * }
  */
 #define list_forEach(e, l) \
-    for (e = listHead(l); e != NULL; e = listNext(l))
+    for (list_iterator list_it_ = listIterator(l); ((e) = listIteratorNext(&list_it_)) != NULL; )
+
+/**
+ * @brief Creates a new intrusive list.
+ *
+ * The list chains its elements through the `list_link` embedded in them, so adding and removing
+ * elements takes constant time and allocates nothing. The elements are not copied: the list
+ * holds the elements themselves and frees them with `elem_free` when they are deleted or the
+ * list is destroyed.
+ *
+ * @param linkOffset The offset of the `list_link` member inside the elements (`offsetof(type, member)`).
+ * @param print Function pointer for printing an element.
+ * @param elem_free Function pointer for freeing the memory of an element.
+ *
+ * @return
+ * - Pointer to the newly created intrusive list if memory allocation is successful.
+ * - `NULL` if memory allocation fails.
+ */
+intrusive_list createIntrusiveList(size_t linkOffset, PrintFunction print, FreeFunction elem_free);
+/**
+ * @brief Resets the link of an element so it is known to be in no list.
+ *
+ * Must be called once on every element before it is first linked into an intrusive list.
+ *
+ * @param link Pointer to the link embedded in the element.
+ *
+ * @return Void.
+ */
+void initListLink(list_link *link);
+/**
+ * @brief Appends an element to the end of an intrusive list.
+ *
+ * @param list Pointer to the intrusive list.
+ * @param elem The element to append. It is linked as is, not copied.
+ *
+ * @return
+ * - `success` if the element is appended.
+ * - `failure` if the list or element is `NULL`, or the link of the element is already in a list.
+ */
+status linkElement(intrusive_list list, Element elem);
+/**
+ * @brief Removes an element from an intrusive list without freeing it.
+ *
+ * The element is reached through its own link, so no search takes place. The element may be
+ * removed while the list is being iterated.
+ *
+ * @param list Pointer to the intrusive list holding the element.
+ * @param elem The element to remove.
+ *
+ * @return
+ * - `success` if the element is removed.
+ * - `failure` if the list or element is `NULL`, or the element is in no list.
+ */
+status unlinkElement(intrusive_list list, Element elem);
+/**
+ * @brief Removes an element from an intrusive list and frees it with the list's `FreeFunction`.
+ *
+ * @param list Pointer to the intrusive list holding the element.
+ * @param elem The element to delete.
+ *
+ * @return
+ * - `success` if the element is removed and freed.
+ * - `failure` if the list or element is `NULL`, or the element is in no list.
+ */
+status deleteElement(intrusive_list list, Element elem);
+/**
+ * @brief Retrieves the number of elements in an intrusive list.
+ *
+ * @param list Pointer to the intrusive list.
+ *
+ * @return
+ * - The number of elements in the list.
+ * - `0` if the list is `NULL`.
+ */
+int getLengthIntrusiveList(intrusive_list list);
+/**
+ * @brief Helper function for initializing the iterator of an intrusive list.
+ *
+ * @param list Pointer to the intrusive list.
+ *
+ * @return
+ * - The first element of the list.
+ * - `NULL` if the list is `NULL` or empty.
+ */
+Element intrusiveHead(intrusive_list list);
+/**
+ * @brief Helper function for moving the iterator of an intrusive list to the next element.
+ *
+ * @param list Pointer to the intrusive list.
+ *
+ * @return
+ * - The next element of the list.
+ * - `NULL` if the list is `NULL` or there is no next element.
+ */
+Element intrusiveNext(intrusive_list list);
+/**
+ * @brief Displays all elements of an intrusive list in order, using the list's `PrintFunction`.
+ *
+ * @param list Pointer to the intrusive list.
+ *
+ * @return
+ * - `success` if the list is displayed.
+ * - `failure` if the list is `NULL`.
+ */
+status displayIntrusiveList(intrusive_list list);
+/**
+ * @brief Frees an intrusive list together with all the elements it holds.
+ *
+ * @param list Pointer to the intrusive list. The function performs no operation if it is `NULL`.
+ *
+ * @return Void.
+ */
+void destroyIntrusiveList(intrusive_list list);
+/**
+ * @brief Creates an iterator positioned before the first element of an intrusive list.
+ *
+ * @param list Pointer to the intrusive list. A `NULL` list gives an iterator with no elements.
+ *
+ * @return The iterator, to be advanced with `intrusiveIteratorNext`.
+ */
+intrusive_iterator intrusiveIterator(intrusive_list list);
+/**
+ * @brief Advances an intrusive list iterator and returns the element it passed over.
+ *
+ * The list must not be changed while the iterator is in use, except that the element just
+ * returned may be unlinked or deleted.
+ *
+ * @param it Pointer to the iterator.
+ *
+ * @return
+ * - The next element of the list.
+ * - `NULL` once all the elements were returned.
+ */
+static inline Element intrusiveIteratorNext(intrusive_iterator *it) {
+    if (it->nextLink == it->end) return NULL;
+    Element elem = (Element) ((char *) it->nextLink - it->linkOffset);
+    it->nextLink = it->nextLink->next;
+    return elem;
+}
+/**
+ * @brief Macro for iterating through all elements of an intrusive list, in the manner of `list_forEach`.
+ *
+ * Each loop keeps its own `intrusive_iterator`, so loops may be nested and run from several threads.
+ *
+ * @param e The variable to hold the current element during the iteration.
+ * @param l The intrusive list to iterate over.
+ */
+#define intrusive_forEach(e, l) \
+    for (intrusive_iterator intrusive_it_ = intrusiveIterator(l); ((e) = intrusiveIteratorNext(&intrusive_it_)) != NULL; )
 
 #endif
\ No newline at end of file
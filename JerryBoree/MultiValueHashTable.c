@@ -2,6 +2,10 @@
 #include "HashTable.h"
 #include "LinkedList.h"
 
+/**
+ * @brief Number of pairs whose collections `addManyToMultiValueHashTable` looks up together.
+ */
+#define MULTI_VALUE_BATCH 16
 
 struct MultiValueHashTable_rec {
     hashTable hashTable;
@@ -14,8 +18,28 @@ struct MultiValueHashTable_rec {
     PrintFunction printValue;
     EqualFunction equalKey;
     EqualFunction equalValue;
-    TransformIntoNumberFunction transformIntoNumber;
+    HashFunction hashKey;
+    HashFunction hashValue;
+    const allocator *alloc;
 };
+
+/** The number of values of a key from which they are indexed by a hash set (see `value_bag_rec`). */
+#define BAG_INDEX_THRESHOLD 32
+
+typedef struct value_bag_rec {
+    /**
+ * @brief The values of one key.
+ *
+ * `values` keeps the values in insertion order. While there are few of them they sit in an
+ * unrolled list and are found by scanning. Once a key holds `BAG_INDEX_THRESHOLD` values (and
+ * a value hash was set) the list switches to nodes and `index` maps every value to its node, so
+ * duplicate checks and removals take O(1). The index is dropped again when the bag shrinks
+ * under half the threshold.
+ */
+    linked_list values;
+    hashTable index;
+    const allocator *alloc;
+} value_bag_rec, *value_bag;
 Element elem_to_elem(Element value) {
     /**
  * @brief Returns the given element as is.
@@ -29,64 +53,148 @@ Element elem_to_elem(Element value) {
     return value;
 }
 
-status destroy_ll_as_elem(Element elem) {
+status leave_elem(Element elem) {
+    /**
+ * @brief Leaves an element as it is. Serves as the free and print function of the bag indexes,
+ * whose keys and values belong to the bag's list.
+ *
+ * @param elem The element.
+ * @return `success`.
+ */
+    return success;
+}
+
+value_bag create_bag(MultiValueHashTable mtv) {
     /**
- * @brief Destroys a linked list when treated as an element.
+ * @brief Creates an empty bag for the values of a key in the multi-value hash table.
  *
- * This helper function integrates the linked list ADT with the multi-value hash table
- * by allowing linked lists to be treated as elements. It deallocates all memory used
- * by the linked list.
+ * @param mtv Pointer to the multi-value hash table.
+ * @return
+ * - A pointer to the newly created bag.
+ * - `NULL` if memory allocation fails.
+ */
+    value_bag bag = (value_bag) allocateBlock(mtv->alloc, sizeof(value_bag_rec));
+    if (bag == NULL) return NULL;
+    //a few values are scanned as a whole, so they are kept in contiguous chunks
+    bag->values = createUnrolledLinkedListWithAllocator(mtv->copyValue, mtv->equalValue, mtv->printValue,
+        mtv->freeValue, elem_to_elem, mtv->alloc);
+    bag->index = NULL;
+    bag->alloc = mtv->alloc;
+    if (bag->values == NULL) {
+        releaseBlock(mtv->alloc, bag, sizeof(value_bag_rec));
+        return NULL;
+    }
+    return bag;
+}
+
+status destroy_bag_as_elem(Element elem) {
+    /**
+ * @brief Destroys a bag of values, with its list and index, when treated as an element.
  *
- * @param elem The element representing the linked list to be destroyed.
+ * @param elem The element representing the bag to be destroyed.
  * @return
- * - `success` if the linked list is successfully destroyed.
+ * - `success` if the bag is successfully destroyed.
  * - `failure` if the input element is `NULL`.
  */
     if (elem == NULL) return  failure;
-    linked_list ll = (linked_list) elem;
-    destroyList(ll);
+    value_bag bag = (value_bag) elem;
+    destroyHashTable(bag->index);
+    destroyList(bag->values);
+    releaseBlock(bag->alloc, bag, sizeof(value_bag_rec));
     return success;
 }
 
-status print_ll_as_elem(Element elem) {
+status print_bag_as_elem(Element elem) {
     /**
- * @brief Prints a linked list when treated as an element.
+ * @brief Prints the values of a bag in insertion order when treated as an element.
  *
- * This helper function integrates the linked list ADT with the multi-value hash table
- * by allowing linked lists to be treated as elements. It displays all elements in the
- * linked list.
- *
- * @param elem The element representing the linked list to be printed.
+ * @param elem The element representing the bag to be printed.
  * @return
- * - `success` if the linked list is successfully displayed.
+ * - `success` if the values are successfully displayed.
  * - `failure` if the input element is `NULL`.
  */
     if (elem == NULL) return  failure;
-    linked_list ll = (linked_list) elem;
-    displayList(ll);
+    value_bag bag = (value_bag) elem;
+    displayList(bag->values);
     return success;
 }
 
-linked_list create_inner_ll(MultiValueHashTable mtv) {
+static void build_index(MultiValueHashTable mtv, value_bag bag) {
     /**
- * @brief Creates a linked list for managing values in the multi-value hash table.
+ * @brief Moves the values of a bag into nodes and indexes every value by its node.
  *
- * @param mtv Pointer to the multi-value hash table.
- * @return
- * - A pointer to the newly created linked list.
- * - `NULL` if memory allocation fails.
+ * On failure the bag simply stays unindexed and keeps working by scanning.
+ */
+    if (setListUnrolled(bag->values, false) == failure) return;
+    hashTable index = createHashTableWithEngine(elem_to_elem, leave_elem, leave_elem, elem_to_elem, leave_elem,
+        leave_elem, mtv->equalValue, mtv->hashValue, 2 * BAG_INDEX_THRESHOLD, openAddressingEngine);
+    if (index == NULL) return;
+    for (list_node h = getHeadNode(bag->values); h != NULL; h = getNextNode(h)) {
+        if (addToHashTable(index, getNodeData(h), h) == failure) {
+            destroyHashTable(index);
+            return;
+        }
+    }
+    bag->index = index;
+}
+
+static void drop_index(value_bag bag) {
+    /**
+ * @brief Drops the index of a bag that became small and packs its values back into chunks.
+ */
+    destroyHashTable(bag->index);
+    bag->index = NULL;
+    setListUnrolled(bag->values, true);
+}
+
+static status bag_add(MultiValueHashTable mtv, value_bag bag, Element value) {
+    /**
+ * @brief Adds a copy of a value to a bag unless an equal value is already in it.
+ */
+    if (bag->index == NULL) {
+        if (borrowByKey(bag->values, value) != NULL) return failure; // check if value already map to key
+        if (appendNode(bag->values, value) == failure) return failure;
+        if (mtv->hashValue != NULL && getLengthList(bag->values) >= BAG_INDEX_THRESHOLD) build_index(mtv, bag);
+        return success;
+    }
+    if (borrowFromHashTable(bag->index, value) != NULL) return failure;
+    list_node h = appendNodeHandle(bag->values, value);
+    if (h == NULL) return failure;
+    //the index is keyed by the stored copy, which lives as long as the entry
+    if (addToHashTable(bag->index, getNodeData(h), h) == failure) {
+        unlinkNode(bag->values, h);
+        return failure;
+    }
+    return success;
+}
+
+static status bag_remove(value_bag bag, Element value) {
+    /**
+ * @brief Removes the value equal to a given value from a bag.
  */
-    linked_list ll = createLinkedList(mtv->copyValue, mtv->equalValue, mtv->printValue, mtv->freeValue, elem_to_elem );
-    return ll;
+    if (bag->index == NULL) return deleteNode(bag->values, value);
+    list_node h = (list_node) borrowFromHashTable(bag->index, value);
+    if (h == NULL) return failure;
+    removeFromHashTable(bag->index, value);
+    unlinkNode(bag->values, h);
+    if (getLengthList(bag->values) < BAG_INDEX_THRESHOLD / 2) drop_index(bag);
+    return success;
 }
 
 MultiValueHashTable createMultiValueHashTable(CopyFunction copyKey, FreeFunction freeKey, PrintFunction printKey,
     CopyFunction copyValue, FreeFunction freeValue, PrintFunction printValue, EqualFunction equalKey,
-    EqualFunction equalValue,TransformIntoNumberFunction transformIntoNumber,int size) {
+    EqualFunction equalValue,HashFunction hashKey,int size) {
+    return createMultiValueHashTableWithAllocator(copyKey, freeKey, printKey, copyValue, freeValue, printValue,
+        equalKey, equalValue, hashKey, size, NULL);
+}
+
+MultiValueHashTable createMultiValueHashTableWithAllocator(CopyFunction copyKey, FreeFunction freeKey,
+    PrintFunction printKey, CopyFunction copyValue, FreeFunction freeValue, PrintFunction printValue,
+    EqualFunction equalKey, EqualFunction equalValue, HashFunction hashKey, int size, const allocator *alloc) {
     MultiValueHashTable mtv = (MultiValueHashTable) malloc(sizeof(struct MultiValueHashTable_rec));
     if (mtv == NULL) return NULL;
-    hashTable hashTable = createHashTable(copyKey, freeKey, printKey, elem_to_elem, destroy_ll_as_elem,
-        print_ll_as_elem, equalKey, transformIntoNumber, size);
+    hashTable hashTable = createHashTableWithAllocator(copyKey, freeKey, printKey, elem_to_elem, destroy_bag_as_elem,
+        print_bag_as_elem, equalKey, hashKey, size, chainingEngine, alloc);
     if (hashTable == NULL) {
         free(mtv);
         return NULL;
@@ -101,9 +209,32 @@ MultiValueHashTable createMultiValueHashTable(CopyFunction copyKey, FreeFunction
     mtv->printValue = printValue;
     mtv->equalKey = equalKey;
     mtv->equalValue = equalValue;
-    mtv->transformIntoNumber = transformIntoNumber;
+    mtv->hashKey = hashKey;
+    mtv->hashValue = NULL;
+    mtv->alloc = alloc;
     return mtv;
 }
+status setMultiValueHashTableLoadFactors(MultiValueHashTable mtv, float maxLoadFactor, float minLoadFactor) {
+    if (mtv == NULL) return failure;
+    return setHashTableLoadFactors(mtv->hashTable, maxLoadFactor, minLoadFactor);
+}
+
+status setMultiValueHashTableKeyCompare(MultiValueHashTable mtv, CompareFunction compareKey) {
+    if (mtv == NULL) return failure;
+    return setHashTableKeyCompare(mtv->hashTable, compareKey);
+}
+
+status setMultiValueHashTableValueHash(MultiValueHashTable mtv, HashFunction hashValue) {
+    if (mtv == NULL) return failure;
+    mtv->hashValue = hashValue;
+    return success;
+}
+
+status setMultiValueHashTableSeed(MultiValueHashTable mtv, uint64_t seed) {
+    if (mtv == NULL) return failure;
+    return setHashTableSeed(mtv->hashTable, seed);
+}
+
 void destroyMultiValueHashTable(MultiValueHashTable mtv) {
     if (mtv == NULL) return;
     destroyHashTable(mtv->hashTable);
@@ -112,35 +243,62 @@ void destroyMultiValueHashTable(MultiValueHashTable mtv) {
 
 status addToMultiValueHashTable(MultiValueHashTable mtv, Element key, Element value) {
     if (mtv == NULL || key == NULL || value == NULL) return  failure;
-    linked_list ll = (linked_list)lookupInHashTable(mtv->hashTable, key);
-    if (ll == NULL) {  //key not exist
-        ll = create_inner_ll(mtv);
-        if (appendNode(ll, value) == failure) {
-            destroyList(ll);
+    bool inserted;
+    Element *slot = findOrInsertInHashTable(mtv->hashTable, key, &inserted);
+    if (slot == NULL) return failure;
+    if (inserted) {  //key not exist
+        *slot = create_bag(mtv);
+        if (*slot == NULL || bag_add(mtv, (value_bag) *slot, value) == failure) {
+            removeFromHashTable(mtv->hashTable, key);
             return failure;
         }
-        addToHashTable(mtv->hashTable, key, ll);
         return success;
     }
-    Element temp = searchByKey(ll, value);
-    if (temp != NULL) { // check if value already map to key
-        return failure;
+    return bag_add(mtv, (value_bag) *slot, value);
+}
+
+status addManyToMultiValueHashTable(MultiValueHashTable mtv, Element *keys, Element *values, int n) {
+    if (mtv == NULL || keys == NULL || values == NULL || n < 0) return failure;
+    status res = success;
+    Element bags[MULTI_VALUE_BATCH];
+    for (int start = 0; start < n; start += MULTI_VALUE_BATCH) {
+        int len = n - start < MULTI_VALUE_BATCH ? n - start : MULTI_VALUE_BATCH;
+        borrowManyFromHashTable(mtv->hashTable, keys + start, len, bags);
+        for (int i = 0; i < len; i++) {
+            Element value = values[start + i];
+            value_bag bag = (value_bag) bags[i];
+            if (bag == NULL || value == NULL) {  //new key (or one added earlier in this batch)
+                if (addToMultiValueHashTable(mtv, keys[start + i], value) == failure) res = failure;
+            } else if (bag_add(mtv, bag, value) == failure) {
+                res = failure;
+            }
+        }
     }
-    if (appendNode(ll, value) == failure) return  failure;
-    return success;
+    return res;
 }
 
 Element lookupInMultiValueHashTable(MultiValueHashTable mtv, Element key) {
     if (mtv == NULL || key == NULL) return NULL;
-    return lookupInHashTable(mtv->hashTable, key);
+    value_bag bag = (value_bag) borrowFromHashTable(mtv->hashTable, key);
+    if (bag == NULL) return NULL;
+    return bag->values;
+}
+
+status lookupManyInMultiValueHashTable(MultiValueHashTable mtv, Element *keys, int n, Element *values) {
+    if (mtv == NULL) return failure;
+    if (borrowManyFromHashTable(mtv->hashTable, keys, n, values) == failure) return failure;
+    for (int i = 0; i < n; i++) {
+        if (values[i] != NULL) values[i] = ((value_bag) values[i])->values;
+    }
+    return success;
 }
 
 status removeFromMultiValueHashTable(MultiValueHashTable mtv, Element key, Element value) {
     if (mtv == NULL || key == NULL || value == NULL) return  failure;
-    linked_list ll = (linked_list) lookupInHashTable(mtv->hashTable, key);
-    if (ll == NULL) return failure;
-    if (deleteNode(ll, value) == failure) return failure;
-    if (getLengthList(ll)==0) {
+    value_bag bag = (value_bag) borrowFromHashTable(mtv->hashTable, key);
+    if (bag == NULL) return failure;
+    if (bag_remove(bag, value) == failure) return failure;
+    if (getLengthList(bag->values)==0) {
        removeFromHashTable(mtv->hashTable, key);
     }
     return success;
@@ -150,4 +308,19 @@ status displayMultiValueHashTable(MultiValueHashTable mtv) {
     if (mtv == NULL) return  failure;
     displayHashElements(mtv->hashTable);
     return success;
-}
\ No newline at end of file
+}
+
+status getMultiValueHashTableStats(MultiValueHashTable mtv, hashTableStats *stats) {
+    if (mtv == NULL) return failure;
+    return getHashTableStats(mtv->hashTable, stats);
+}
+
+status getMultiValueHashTableHistogram(MultiValueHashTable mtv, int *histogram, int length) {
+    if (mtv == NULL) return failure;
+    return getHashTableHistogram(mtv->hashTable, histogram, length);
+}
+
+status resetMultiValueHashTableStats(MultiValueHashTable mtv) {
+    if (mtv == NULL) return failure;
+    return resetHashTableStats(mtv->hashTable);
+}
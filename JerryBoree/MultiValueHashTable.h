@@ -1,6 +1,7 @@
 #ifndef MultiValueHashTable_H
 #define MultiValueHashTable_H
 #include "Defs.h"
+#include "HashTable.h"
 
 typedef struct MultiValueHashTable_rec* MultiValueHashTable;
 
@@ -19,7 +20,7 @@ typedef struct MultiValueHashTable_rec* MultiValueHashTable;
  * @param printValue Function pointer for printing a value.
  * @param equalKey Function pointer for comparing keys for equality.
  * @param equalValue Function pointer for comparing values for equality.
- * @param transformIntoNumber Function pointer for transforming a key into a numeric hash value.
+ * @param hashKey Function pointer for computing the seeded 64 bit hash of a key (see HashFunctions.h).
  * @param size The number of buckets in the hash table.
  *
  * @return
@@ -28,7 +29,77 @@ typedef struct MultiValueHashTable_rec* MultiValueHashTable;
  */
 MultiValueHashTable createMultiValueHashTable(CopyFunction copyKey, FreeFunction freeKey, PrintFunction printKey,
     CopyFunction copyValue, FreeFunction freeValue, PrintFunction printValue, EqualFunction equalKey,
-    EqualFunction equalValue,TransformIntoNumberFunction transformIntoNumber,int size);
+    EqualFunction equalValue,HashFunction hashKey,int size);
+/**
+ * @brief Creates a multi-value hash table whose small objects come from an allocator.
+ *
+ * Works like `createMultiValueHashTable`. The key-value pairs, bucket lists and value lists
+ * with their nodes and chunks are taken from `alloc` (see `createHashTableWithAllocator`).
+ *
+ * @param alloc The allocator of the table (`NULL` for `malloc`). It must outlive the table.
+ *
+ * The other parameters and the return value are those of `createMultiValueHashTable`.
+ */
+MultiValueHashTable createMultiValueHashTableWithAllocator(CopyFunction copyKey, FreeFunction freeKey,
+    PrintFunction printKey, CopyFunction copyValue, FreeFunction freeValue, PrintFunction printValue,
+    EqualFunction equalKey, EqualFunction equalValue, HashFunction hashKey, int size, const allocator *alloc);
+/**
+ * @brief Configures when the multi-value hash table grows and shrinks.
+ *
+ * The keys of a multi-value hash table are kept in a hash table that resizes itself
+ * incrementally. This function forwards the load factors to that hash table.
+ *
+ * @param mtv Pointer to the multi-value hash table.
+ * @param maxLoadFactor The number of keys per bucket above which the table grows.
+ * @param minLoadFactor The number of keys per bucket below which the table shrinks (0 disables shrinking).
+ *
+ * @return
+ * - `success` if the load factors are updated.
+ * - `failure` if the table is `NULL` or the load factors are invalid.
+ */
+status setMultiValueHashTableLoadFactors(MultiValueHashTable mtv, float maxLoadFactor, float minLoadFactor);
+/**
+ * @brief Gives the table an ordering of its keys, used to keep heavily colliding buckets balanced
+ * (see `setHashTableKeyCompare`).
+ *
+ * @param mtv Pointer to the multi-value hash table.
+ * @param compareKey Function pointer for ordering two keys.
+ *
+ * @return
+ * - `success` if the ordering is set.
+ * - `failure` if the table is `NULL` or not empty.
+ */
+status setMultiValueHashTableKeyCompare(MultiValueHashTable mtv, CompareFunction compareKey);
+/**
+ * @brief Gives the table a hash function for values, so that keys with many values index them.
+ *
+ * Without it, adding or removing a value scans all the values of the key. With it, once a key
+ * holds 32 values they are also kept in a hash set, and adding (with its duplicate check) and
+ * removing a value take O(1) however many values the key has. The hash must agree with
+ * `equalValue`: equal values must have equal hashes.
+ *
+ * @param mtv Pointer to the multi-value hash table.
+ * @param hashValue Function pointer for computing the seeded 64 bit hash of a value, or `NULL`
+ *                  to stop indexing keys that grow from now on.
+ *
+ * @return
+ * - `success` if the hash function is set.
+ * - `failure` if the table is `NULL`.
+ */
+status setMultiValueHashTableValueHash(MultiValueHashTable mtv, HashFunction hashValue);
+/**
+ * @brief Changes the seed passed to the multi-value hash table's hash function.
+ *
+ * The seed can only be changed while the table is empty.
+ *
+ * @param mtv Pointer to the multi-value hash table.
+ * @param seed The new seed.
+ *
+ * @return
+ * - `success` if the seed is updated.
+ * - `failure` if the table is `NULL` or not empty.
+ */
+status setMultiValueHashTableSeed(MultiValueHashTable mtv, uint64_t seed);
 /**
  * @brief Destroys a multi-value hash table and frees all associated memory.
  *
@@ -57,11 +128,29 @@ void destroyMultiValueHashTable(MultiValueHashTable mtv);
  *   or the key-value pair already exists.
  */
 status addToMultiValueHashTable(MultiValueHashTable mtv, Element key, Element value);
+/**
+ * @brief Adds many key-value pairs to the multi-value hash table.
+ *
+ * Works like calling `addToMultiValueHashTable` on every pair, but the collections of the keys
+ * are looked up in batches (see `borrowManyFromHashTable`), so the cache misses of a batch overlap.
+ *
+ * @param mtv Pointer to the multi-value hash table.
+ * @param keys The keys to associate with the values.
+ * @param values The values to be added, `values[i]` for `keys[i]`.
+ * @param n The number of pairs.
+ *
+ * @return
+ * - `success` if all the pairs are added.
+ * - `failure` if the table or one of the arrays is `NULL`, `n` is negative, or at least
+ *   one pair is not added (see `addToMultiValueHashTable`).
+ */
+status addManyToMultiValueHashTable(MultiValueHashTable mtv, Element *keys, Element *values, int n);
 /**
  * @brief Retrieves the values associated with a given key in the multi-value hash table.
  *
  * This function looks up a key in the multi-value hash table and returns the collection of
- * values associated with that key.
+ * values associated with that key: a `linked_list` of the values in insertion order, still
+ * owned by the table.
  *
  * @param mtv Pointer to the multi-value hash table.
  * @param key The key to search for.
@@ -71,6 +160,23 @@ status addToMultiValueHashTable(MultiValueHashTable mtv, Element key, Element va
  * - `NULL` if the table or key is `NULL`, or if the key does not exist in the hash table.
  */
 Element lookupInMultiValueHashTable(MultiValueHashTable mtv, Element key);
+/**
+ * @brief Retrieves the values associated with many keys in the multi-value hash table.
+ *
+ * Works like calling `lookupInMultiValueHashTable` on every key, but the keys are hashed and
+ * prefetched in batches (see `borrowManyFromHashTable`).
+ *
+ * @param mtv Pointer to the multi-value hash table.
+ * @param keys The keys to search for.
+ * @param n The number of keys.
+ * @param values Output array receiving the collection of values of every key, or `NULL` for
+ *               keys that do not exist.
+ *
+ * @return
+ * - `success` if all the keys are searched.
+ * - `failure` if the table or one of the arrays is `NULL`, or `n` is negative.
+ */
+status lookupManyInMultiValueHashTable(MultiValueHashTable mtv, Element *keys, int n, Element *values);
 /**
  * @brief Removes a value associated with a key from the multi-value hash table.
  *
@@ -101,5 +207,41 @@ status removeFromMultiValueHashTable(MultiValueHashTable mtv, Element key, Eleme
  * - `failure` if the table is `NULL`.
  */
 status displayMultiValueHashTable(MultiValueHashTable mtv);
+/**
+ * @brief Reports the occupancy of the multi-value hash table and the cost of its searches.
+ *
+ * The statistics describe the keys of the table; every key counts once however many values
+ * it has (see `getHashTableStats`).
+ *
+ * @param mtv Pointer to the multi-value hash table.
+ * @param stats Output parameter receiving the statistics.
+ *
+ * @return
+ * - `success` if the statistics are filled in.
+ * - `failure` if the table or `stats` is `NULL`.
+ */
+status getMultiValueHashTableStats(MultiValueHashTable mtv, hashTableStats *stats);
+/**
+ * @brief Computes how long the chains of the multi-value hash table are (see `getHashTableHistogram`).
+ *
+ * @param mtv Pointer to the multi-value hash table.
+ * @param histogram Output array of `length` counters.
+ * @param length The number of counters.
+ *
+ * @return
+ * - `success` if the histogram is filled in.
+ * - `failure` if the table or `histogram` is `NULL`, or `length` is not positive.
+ */
+status getMultiValueHashTableHistogram(MultiValueHashTable mtv, int *histogram, int length);
+/**
+ * @brief Sets the search and resize counters of the multi-value hash table back to 0.
+ *
+ * @param mtv Pointer to the multi-value hash table.
+ *
+ * @return
+ * - `success` if the counters are reset.
+ * - `failure` if the table is `NULL`.
+ */
+status resetMultiValueHashTableStats(MultiValueHashTable mtv);
 
 #endif
\ No newline at end of file
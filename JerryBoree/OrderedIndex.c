@@ -0,0 +1,229 @@
+#include "OrderedIndex.h"
+#include <math.h>
+
+/** The highest level a node may reach; with a 1/4 promotion chance this covers any index that fits in memory. */
+#define MAX_LEVEL 16
+
+typedef struct order_node_rec {
+    /**
+ * @brief A node of the skip list.
+ *
+ * `next[i]` is the next node at level `i` (level 0 joins all the nodes by increasing key), and
+ * `prev` the previous node at level 0 (`NULL` for the first node), so ranges can be walked both ways.
+ * `order` is the number of insertions made before the node's one, which ranks elements with
+ * equally close keys.
+ */
+    float key;
+    uint64_t order;
+    Element data;
+    struct order_node_rec *prev;
+    int level;
+    struct order_node_rec *next[];
+} order_node_rec, *order_node;
+
+struct ordered_index_rec {
+    /**
+ * @brief Structure representing an ordered index.
+ *
+ * - `head`: A sentinel node before the smallest key holding links at every level.
+ * - `tail`: The node with the largest key (`NULL` if the index is empty).
+ * - `level`: The number of levels currently in use.
+ * - `insertions`: The number of insertions made so far.
+ * - `random`: The state of the generator choosing the level of new nodes.
+ */
+    order_node head;
+    order_node tail;
+    int level;
+    int length;
+    uint64_t insertions;
+    uint64_t random;
+    Element(*CopyFunction) (Element);
+    status(*FreeFunction) (Element);
+    status(*PrintFunction) (Element);
+    bool(*EqualFunction) (Element, Element);
+};
+
+static order_node create_order_node(int level) {
+    return (order_node) malloc(sizeof(order_node_rec) + level * sizeof(order_node));
+}
+
+static int random_level(ordered_index index) {
+    /**
+ * @brief Draws the level of a new node: every level above the first is reached with chance 1/4.
+ */
+    index->random ^= index->random << 13;
+    index->random ^= index->random >> 7;
+    index->random ^= index->random << 17;
+    uint64_t bits = index->random;
+    int level = 1;
+    while (level < MAX_LEVEL && (bits & 3) == 0) {
+        level++;
+        bits >>= 2;
+    }
+    return level;
+}
+
+static order_node find_before(ordered_index index, float key, bool pastEqual, order_node *update) {
+    /**
+ * @brief Walks down the levels to the last node whose key is below `key`.
+ *
+ * @param pastEqual Whether the nodes whose key equals `key` are walked past as well.
+ * @param update Output array receiving, for each level in use, the last node walked to (may be `NULL`).
+ * @return The last node walked to at level 0 (the head if there is none).
+ */
+    order_node x = index->head;
+    for (int lvl = index->level - 1; lvl >= 0; lvl--) {
+        while (x->next[lvl] != NULL && (x->next[lvl]->key < key || (pastEqual && x->next[lvl]->key == key))) {
+            x = x->next[lvl];
+        }
+        if (update != NULL) update[lvl] = x;
+    }
+    return x;
+}
+
+ordered_index createOrderedIndex(CopyFunction copy, EqualFunction equal, PrintFunction print, FreeFunction elem_free) {
+    ordered_index newIndex = (ordered_index) malloc(sizeof(struct ordered_index_rec));
+    if (newIndex == NULL)
+        return NULL;
+    newIndex->head = create_order_node(MAX_LEVEL);
+    if (newIndex->head == NULL) {
+        free(newIndex);
+        return NULL;
+    }
+    newIndex->head->data = NULL;
+    newIndex->head->level = MAX_LEVEL;
+    newIndex->head->next[0] = NULL;
+    newIndex->tail = NULL;
+    newIndex->level = 1;
+    newIndex->length = 0;
+    newIndex->insertions = 0;
+    newIndex->random = 0x9E3779B97F4A7C15ULL;
+    newIndex->CopyFunction = copy;
+    newIndex->EqualFunction = equal;
+    newIndex->PrintFunction = print;
+    newIndex->FreeFunction = elem_free;
+    return newIndex;
+}
+
+status insertToOrderedIndex(ordered_index index, float key, Element elem) {
+    if (index == NULL) return failure;
+    int level = random_level(index);
+    order_node added = create_order_node(level);
+    if (added == NULL) return failure;
+    added->key = key;
+    added->order = index->insertions++;
+    added->data = index->CopyFunction(elem);
+    added->level = level;
+    for (int lvl = index->level; lvl < level; lvl++) index->head->next[lvl] = NULL;
+    if (level > index->level) index->level = level;
+    order_node update[MAX_LEVEL];
+    find_before(index, key, true, update);
+    for (int lvl = 0; lvl < level; lvl++) {
+        added->next[lvl] = update[lvl]->next[lvl];
+        update[lvl]->next[lvl] = added;
+    }
+    added->prev = update[0] == index->head ? NULL : update[0];
+    if (added->next[0] != NULL) added->next[0]->prev = added;
+    else index->tail = added;
+    index->length++;
+    return success;
+}
+
+status removeFromOrderedIndex(ordered_index index, float key, Element elem) {
+    if (index == NULL) return failure;
+    order_node update[MAX_LEVEL];
+    find_before(index, key, false, update);
+    //the element is searched among the nodes holding the key, keeping the links leading to it
+    order_node removed = update[0]->next[0];
+    while (removed != NULL && removed->key == key && index->EqualFunction(removed->data, elem) == false) {
+        for (int lvl = 0; lvl < removed->level; lvl++) update[lvl] = removed;
+        removed = removed->next[0];
+    }
+    if (removed == NULL || removed->key != key) return failure;
+    for (int lvl = 0; lvl < removed->level; lvl++) {
+        update[lvl]->next[lvl] = removed->next[lvl];
+    }
+    if (removed->next[0] != NULL) removed->next[0]->prev = removed->prev;
+    else index->tail = removed->prev;
+    while (index->level > 1 && index->head->next[index->level - 1] == NULL) index->level--;
+    index->length--;
+    index->FreeFunction(removed->data);
+    free(removed);
+    return success;
+}
+
+Element nearestInOrderedIndex(ordered_index index, float key) {
+    if (index == NULL || index->length == 0) return NULL;
+    order_node below = find_before(index, key, false, NULL);
+    order_node above = below->next[0];
+    if (below == index->head) return above->data;
+    //the closest key below is held first by the node following the last one under it
+    below = find_before(index, below->key, false, NULL)->next[0];
+    if (above == NULL) return below->data;
+    float belowDif = fabs(key - below->key);
+    float aboveDif = fabs(key - above->key);
+    if (belowDif < aboveDif || (belowDif == aboveDif && below->order < above->order)) return below->data;
+    return above->data;
+}
+
+ordered_range rangeOfOrderedIndex(ordered_index index, float low, float high) {
+    ordered_range range = { NULL, high, 0, false };
+    if (index == NULL || low > high) return range;
+    range.next = find_before(index, low, false, NULL)->next[0];
+    range.remaining = index->length;
+    return range;
+}
+
+ordered_range smallestOfOrderedIndex(ordered_index index, int count) {
+    ordered_range range = { NULL, INFINITY, 0, false };
+    if (index == NULL || count <= 0) return range;
+    range.next = index->head->next[0];
+    range.remaining = count;
+    return range;
+}
+
+ordered_range largestOfOrderedIndex(ordered_index index, int count) {
+    ordered_range range = { NULL, -INFINITY, 0, true };
+    if (index == NULL || count <= 0) return range;
+    range.next = index->tail;
+    range.remaining = count;
+    return range;
+}
+
+Element orderedRangeNext(ordered_range *range) {
+    if (range == NULL || range->remaining == 0 || range->next == NULL) return NULL;
+    order_node x = range->next;
+    if (range->descending ? x->key < range->bound : x->key > range->bound) {
+        range->next = NULL;
+        return NULL;
+    }
+    range->next = range->descending ? x->prev : x->next[0];
+    range->remaining--;
+    return x->data;
+}
+
+int getLengthOrderedIndex(ordered_index index) {
+    if (index == NULL) return 0;
+    return index->length;
+}
+
+status displayOrderedIndex(ordered_index index) {
+    if (index == NULL) return failure;
+    for (order_node x = index->head->next[0]; x != NULL; x = x->next[0]) {
+        index->PrintFunction(x->data);
+    }
+    return success;
+}
+
+void destroyOrderedIndex(ordered_index index) {
+    if (index == NULL) return;
+    order_node x = index->head->next[0];
+    while (x != NULL) {
+        order_node next = x->next[0];
+        index->FreeFunction(x->data);
+        free(x);
+        x = next;
+    }
+    free(index->head);
+    free(index);
+}
@@ -0,0 +1,164 @@
+#ifndef ORDERED_INDEX_H
+#define ORDERED_INDEX_H
+#include "Defs.h"
+
+typedef struct ordered_index_rec* ordered_index;
+
+/**
+ * @brief A view of the elements of an ordered index whose keys follow each other, kept by the caller.
+ *
+ * Members (not to be accessed directly):
+ *   - next: The node whose element is returned next.
+ *   - bound: The key past which the view ends.
+ *   - remaining: The largest number of elements still to be returned.
+ *   - descending: Whether the view walks by decreasing key.
+ */
+typedef struct {
+    struct order_node_rec *next;
+    float bound;
+    int remaining;
+    bool descending;
+} ordered_range;
+
+/**
+ * @brief Creates a new ordered index with specified utility functions.
+ *
+ * An ordered index keeps elements sorted by a numeric key, so that the elements whose keys are
+ * near a given value are found without looking at the others. It is built as a skip list:
+ * inserting, removing and finding the nearest key take O(log n) expected steps, and a range of
+ * keys or the smallest and largest keys are visited from there one step per element. Several
+ * elements may share a key; they are kept in the order they were inserted.
+ *
+ * @param copy Function pointer for creating a deep copy of an element.
+ * @param equal Function pointer for comparing two elements for equality.
+ * @param print Function pointer for printing an element.
+ * @param elem_free Function pointer for freeing the memory of an element.
+ *
+ * @return
+ * - Pointer to the newly created ordered index if memory allocation is successful.
+ * - `NULL` if memory allocation fails.
+ */
+ordered_index createOrderedIndex(CopyFunction copy, EqualFunction equal, PrintFunction print, FreeFunction elem_free);
+/**
+ * @brief Inserts a copy of an element under a key, after the elements already holding that key.
+ *
+ * @param index Pointer to the ordered index.
+ * @param key The key of the element.
+ * @param elem The element to insert. The element is copied using the index's `CopyFunction`.
+ *
+ * @return
+ * - `success` if the element is inserted.
+ * - `failure` if the index is `NULL` or memory allocation fails.
+ */
+status insertToOrderedIndex(ordered_index index, float key, Element elem);
+/**
+ * @brief Removes an element stored under a key and frees it using the index's `FreeFunction`.
+ *
+ * @param index Pointer to the ordered index.
+ * @param key The key the element was inserted with.
+ * @param elem The element to remove, compared using the index's `EqualFunction`.
+ *
+ * @return
+ * - `success` if the element is removed.
+ * - `failure` if the index is `NULL` or no element equal to `elem` is stored under the key.
+ */
+status removeFromOrderedIndex(ordered_index index, float key, Element elem);
+/**
+ * @brief Retrieves the element whose key is the closest to a value, without copying it.
+ *
+ * Only the elements just below and just above the value are compared. When both are as close,
+ * or several elements share the closest key, the one inserted first is returned.
+ *
+ * @param index Pointer to the ordered index.
+ * @param key The value to approach.
+ *
+ * @return
+ * - The element with the closest key (still owned by the index).
+ * - `NULL` if the index is `NULL` or empty.
+ */
+Element nearestInOrderedIndex(ordered_index index, float key);
+/**
+ * @brief Creates a view of the elements whose keys lie between two values, by increasing key.
+ *
+ * Reaching the first element takes O(log n) steps and every further element one step, so the
+ * cost depends on the number of elements in the range rather than on the size of the index.
+ * The index must not be changed while the view is in use.
+ *
+ * @param index Pointer to the ordered index.
+ * @param low The smallest key of the view.
+ * @param high The largest key of the view.
+ *
+ * @return The view, to be read with `orderedRangeNext`. It is empty if the index is `NULL` or
+ * `low` is above `high`.
+ */
+ordered_range rangeOfOrderedIndex(ordered_index index, float low, float high);
+/**
+ * @brief Creates a view of the `count` elements with the smallest keys, by increasing key.
+ *
+ * @param index Pointer to the ordered index.
+ * @param count The largest number of elements in the view. The view ends early at the end of the index.
+ *
+ * @return The view, to be read with `orderedRangeNext`. It is empty if the index is `NULL` or
+ * the count is not positive.
+ */
+ordered_range smallestOfOrderedIndex(ordered_index index, int count);
+/**
+ * @brief Creates a view of the `count` elements with the largest keys, by decreasing key.
+ *
+ * Elements sharing a key are returned in the reverse of their insertion order.
+ *
+ * @param index Pointer to the ordered index.
+ * @param count The largest number of elements in the view. The view ends early at the start of the index.
+ *
+ * @return The view, to be read with `orderedRangeNext`. It is empty if the index is `NULL` or
+ * the count is not positive.
+ */
+ordered_range largestOfOrderedIndex(ordered_index index, int count);
+/**
+ * @brief Returns the next element of a view without copying it.
+ *
+ * @param range Pointer to the view.
+ *
+ * @return
+ * - The next element of the view (still owned by the index).
+ * - `NULL` once all the elements of the view were returned.
+ */
+Element orderedRangeNext(ordered_range *range);
+/**
+ * @brief Retrieves the number of elements in the ordered index.
+ *
+ * @param index Pointer to the ordered index.
+ *
+ * @return
+ * - The number of elements in the index.
+ * - `0` if the index is `NULL`.
+ */
+int getLengthOrderedIndex(ordered_index index);
+/**
+ * @brief Displays all elements of the ordered index by increasing key, using the index's `PrintFunction`.
+ *
+ * @param index Pointer to the ordered index.
+ *
+ * @return
+ * - `success` if the index is displayed.
+ * - `failure` if the index is `NULL`.
+ */
+status displayOrderedIndex(ordered_index index);
+/**
+ * @brief Frees an ordered index together with all the elements it holds.
+ *
+ * @param index Pointer to the ordered index. The function performs no operation if it is `NULL`.
+ *
+ * @return Void.
+ */
+void destroyOrderedIndex(ordered_index index);
+/**
+ * @brief Macro for iterating through the elements of a view of an ordered index.
+ *
+ * @param e The variable to hold the current element during the iteration.
+ * @param range The view to iterate over, e.g. `rangeOfOrderedIndex(index, low, high)`.
+ */
+#define ordered_forEach(e, range) \
+    for (ordered_range ordered_it_ = (range); ((e) = orderedRangeNext(&ordered_it_)) != NULL; )
+
+#endif
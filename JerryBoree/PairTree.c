@@ -0,0 +1,254 @@
+#include "PairTree.h"
+
+/**
+ * @brief A node of the tree. The hash of the pair is copied into the node, so that walking
+ * down the tree does not touch the pairs themselves.
+ */
+typedef struct tree_node_rec {
+    key_value_pair kvp;
+    uint64_t hash;
+    int height;
+    struct tree_node_rec *left;
+    struct tree_node_rec *right;
+} *tree_node;
+
+struct pair_tree_rec {
+    tree_node root;
+    int size;
+    EqualFunction equalKey;
+    CompareFunction compareKey;
+    PrintFunction printPair;
+};
+
+static int height(tree_node n) {
+    return n == NULL ? 0 : n->height;
+}
+
+static void update_height(tree_node n) {
+    int l = height(n->left), r = height(n->right);
+    n->height = (l > r ? l : r) + 1;
+}
+
+static tree_node rotate_right(tree_node n) {
+    tree_node l = n->left;
+    n->left = l->right;
+    l->right = n;
+    update_height(n);
+    update_height(l);
+    return l;
+}
+
+static tree_node rotate_left(tree_node n) {
+    tree_node r = n->right;
+    n->right = r->left;
+    r->left = n;
+    update_height(n);
+    update_height(r);
+    return r;
+}
+
+static tree_node rebalance(tree_node n) {
+    /**
+ * @brief Restores the AVL property of a node whose subtrees differ in height by at most 2.
+ *
+ * @param n The node to rebalance.
+ * @return The root of the rebalanced subtree.
+ */
+    update_height(n);
+    int balance = height(n->left) - height(n->right);
+    if (balance > 1) {
+        if (height(n->left->left) < height(n->left->right)) n->left = rotate_left(n->left);
+        return rotate_right(n);
+    }
+    if (balance < -1) {
+        if (height(n->right->right) < height(n->right->left)) n->right = rotate_right(n->right);
+        return rotate_left(n);
+    }
+    return n;
+}
+
+static int order(pair_tree tree, Element key, uint64_t hash, tree_node n) {
+    /**
+ * @brief Compares a key with the key of a node.
+ *
+ * @return
+ * - A negative number or a positive number if the key belongs to the left or to the right of the node.
+ * - `0` if the keys are equal, or, without `compareKey`, if the hashes are equal.
+ */
+    if (hash != n->hash) return hash < n->hash ? -1 : 1;
+    if (tree->compareKey == NULL) return 0;
+    return tree->compareKey(key, get_shallow_key(n->kvp));
+}
+
+static bool is_match(pair_tree tree, Element key, tree_node n) {
+    /**
+ * @brief Tells whether a node whose order is 0 holds the key itself.
+ */
+    return tree->compareKey != NULL || tree->equalKey(key, get_shallow_key(n->kvp)) == true;
+}
+
+static tree_node insert_node(pair_tree tree, tree_node n, tree_node added) {
+    if (n == NULL) return added;
+    //pairs that can not be ordered go to the right
+    if (order(tree, get_shallow_key(added->kvp), added->hash, n) < 0) {
+        n->left = insert_node(tree, n->left, added);
+    } else {
+        n->right = insert_node(tree, n->right, added);
+    }
+    return rebalance(n);
+}
+
+static tree_node search_node(pair_tree tree, tree_node n, Element key, uint64_t hash, int *visited) {
+    /**
+ * @brief Searches a subtree for a key. Without `compareKey`, both subtrees of a node with
+ * an equal hash may hold the key, so both are searched.
+ */
+    while (n != NULL) {
+        (*visited)++;
+        int c = order(tree, key, hash, n);
+        if (c < 0) {
+            n = n->left;
+        } else if (c > 0) {
+            n = n->right;
+        } else {
+            if (is_match(tree, key, n)) return n;
+            tree_node found = search_node(tree, n->left, key, hash, visited);
+            if (found != NULL) return found;
+            n = n->right;
+        }
+    }
+    return NULL;
+}
+
+static tree_node detach_min(tree_node n, tree_node *min) {
+    /**
+ * @brief Unlinks the leftmost node of a subtree.
+ *
+ * @param n The root of the subtree.
+ * @param min Output parameter receiving the unlinked node.
+ * @return The root of the rebalanced subtree.
+ */
+    if (n->left == NULL) {
+        *min = n;
+        return n->right;
+    }
+    n->left = detach_min(n->left, min);
+    return rebalance(n);
+}
+
+static tree_node unlink_node(tree_node n) {
+    /**
+ * @brief Frees a node and returns the subtree that replaces it.
+ */
+    tree_node replacement;
+    if (n->left == NULL || n->right == NULL) {
+        replacement = n->left == NULL ? n->right : n->left;
+        free(n);
+        return replacement;
+    }
+    tree_node right = detach_min(n->right, &replacement);
+    replacement->left = n->left;
+    replacement->right = right;
+    free(n);
+    return rebalance(replacement);
+}
+
+static tree_node remove_node(pair_tree tree, tree_node n, Element key, uint64_t hash, key_value_pair *removed) {
+    if (n == NULL) return NULL;
+    int c = order(tree, key, hash, n);
+    if (c < 0) {
+        n->left = remove_node(tree, n->left, key, hash, removed);
+    } else if (c > 0) {
+        n->right = remove_node(tree, n->right, key, hash, removed);
+    } else if (is_match(tree, key, n)) {
+        *removed = n->kvp;
+        return unlink_node(n);
+    } else {
+        n->left = remove_node(tree, n->left, key, hash, removed);
+        if (*removed == NULL) n->right = remove_node(tree, n->right, key, hash, removed);
+    }
+    return rebalance(n);
+}
+
+static void destroy_nodes(tree_node n) {
+    if (n == NULL) return;
+    destroy_nodes(n->left);
+    destroy_nodes(n->right);
+    destroyKeyValuePair(n->kvp);
+    free(n);
+}
+
+static void display_nodes(pair_tree tree, tree_node n) {
+    if (n == NULL) return;
+    display_nodes(tree, n->left);
+    tree->printPair(n->kvp);
+    display_nodes(tree, n->right);
+}
+
+pair_tree createPairTree(EqualFunction equalKey, CompareFunction compareKey, PrintFunction printPair) {
+    pair_tree tree = malloc(sizeof(struct pair_tree_rec));
+    if (tree == NULL) return NULL;
+    tree->root = NULL;
+    tree->size = 0;
+    tree->equalKey = equalKey;
+    tree->compareKey = compareKey;
+    tree->printPair = printPair;
+    return tree;
+}
+
+void destroyPairTree(pair_tree tree) {
+    if (tree == NULL) return;
+    destroy_nodes(tree->root);
+    free(tree);
+}
+
+status insertToPairTree(pair_tree tree, key_value_pair kvp) {
+    if (tree == NULL || kvp == NULL) return failure;
+    tree_node n = malloc(sizeof(struct tree_node_rec));
+    if (n == NULL) return failure;
+    n->kvp = kvp;
+    n->hash = getKeyHash(kvp);
+    n->height = 1;
+    n->left = NULL;
+    n->right = NULL;
+    tree->root = insert_node(tree, tree->root, n);
+    tree->size++;
+    return success;
+}
+
+key_value_pair searchPairTree(pair_tree tree, Element key, uint64_t hash, int *visited) {
+    int count = 0;
+    if (tree == NULL) return NULL;
+    tree_node n = search_node(tree, tree->root, key, hash, &count);
+    if (visited != NULL) *visited = count;
+    return n == NULL ? NULL : n->kvp;
+}
+
+key_value_pair removeFromPairTree(pair_tree tree, Element key, uint64_t hash) {
+    if (tree == NULL) return NULL;
+    key_value_pair removed = NULL;
+    tree->root = remove_node(tree, tree->root, key, hash, &removed);
+    if (removed != NULL) tree->size--;
+    return removed;
+}
+
+key_value_pair popFromPairTree(pair_tree tree) {
+    if (tree == NULL || tree->root == NULL) return NULL;
+    tree_node min;
+    tree->root = detach_min(tree->root, &min);
+    key_value_pair kvp = min->kvp;
+    free(min);
+    tree->size--;
+    return kvp;
+}
+
+int getPairTreeSize(pair_tree tree) {
+    if (tree == NULL) return 0;
+    return tree->size;
+}
+
+status displayPairTree(pair_tree tree) {
+    if (tree == NULL) return failure;
+    display_nodes(tree, tree->root);
+    return success;
+}
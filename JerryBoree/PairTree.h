@@ -0,0 +1,108 @@
+#ifndef PAIR_TREE_H
+#define PAIR_TREE_H
+#include "Defs.h"
+#include "KeyValuePair.h"
+
+typedef struct pair_tree_rec* pair_tree;
+/**
+ * @brief Creates an empty balanced search tree of key-value pairs.
+ *
+ * The tree is an AVL tree ordered by the hash stored in every pair (see `setKeyHash`) and,
+ * among pairs whose hashes are equal, by `compareKey`. Searches therefore take O(log n)
+ * steps however many keys share a bucket. Without `compareKey`, keys with equal hashes can
+ * not be ordered and are searched one by one.
+ *
+ * The tree owns the pairs inserted into it and destroys them with `destroyKeyValuePair`.
+ *
+ * @param equalKey Function pointer for comparing two keys for equality.
+ * @param compareKey Function pointer returning a negative number, 0 or a positive number when
+ *                   the first key is smaller than, equal to or greater than the second (may be `NULL`).
+ * @param printPair Function pointer for printing a pair.
+ *
+ * @return
+ * - Pointer to the newly created tree if memory allocation is successful.
+ * - `NULL` if memory allocation fails.
+ */
+pair_tree createPairTree(EqualFunction equalKey, CompareFunction compareKey, PrintFunction printPair);
+/**
+ * @brief Destroys a tree together with all the pairs it holds.
+ *
+ * @param tree Pointer to the tree. The function performs no operation if it is `NULL`.
+ *
+ * @return Void.
+ */
+void destroyPairTree(pair_tree tree);
+/**
+ * @brief Inserts a key-value pair into the tree.
+ *
+ * The pair is stored as is (not copied) under the hash it carries. The caller must make sure
+ * that its key is not in the tree yet.
+ *
+ * @param tree Pointer to the tree.
+ * @param kvp The key-value pair to insert.
+ *
+ * @return
+ * - `success` if the pair is inserted.
+ * - `failure` if the tree or pair is `NULL`, or memory allocation fails.
+ */
+status insertToPairTree(pair_tree tree, key_value_pair kvp);
+/**
+ * @brief Searches the tree for the pair stored under a key.
+ *
+ * @param tree Pointer to the tree.
+ * @param key The key to search for.
+ * @param hash The hash of the key.
+ * @param visited Output parameter receiving the number of pairs looked at (may be `NULL`).
+ *
+ * @return
+ * - The pair stored under the key (still owned by the tree).
+ * - `NULL` if the tree is `NULL` or the key is not in the tree.
+ */
+key_value_pair searchPairTree(pair_tree tree, Element key, uint64_t hash, int *visited);
+/**
+ * @brief Removes the pair stored under a key from the tree without destroying it.
+ *
+ * @param tree Pointer to the tree.
+ * @param key The key of the pair to remove.
+ * @param hash The hash of the key.
+ *
+ * @return
+ * - The removed pair, which the caller takes over.
+ * - `NULL` if the tree is `NULL` or the key is not in the tree.
+ */
+key_value_pair removeFromPairTree(pair_tree tree, Element key, uint64_t hash);
+/**
+ * @brief Removes the pair with the smallest hash from the tree without destroying it.
+ *
+ * Popping pairs until the tree is empty hands all of them over in order, which is how a
+ * tree is turned back into another container.
+ *
+ * @param tree Pointer to the tree.
+ *
+ * @return
+ * - The removed pair, which the caller takes over.
+ * - `NULL` if the tree is `NULL` or empty.
+ */
+key_value_pair popFromPairTree(pair_tree tree);
+/**
+ * @brief Retrieves the number of pairs in the tree.
+ *
+ * @param tree Pointer to the tree.
+ *
+ * @return
+ * - The number of pairs in the tree.
+ * - `0` if the tree is `NULL`.
+ */
+int getPairTreeSize(pair_tree tree);
+/**
+ * @brief Displays all the pairs of the tree in order.
+ *
+ * @param tree Pointer to the tree.
+ *
+ * @return
+ * - `success` if the pairs are displayed.
+ * - `failure` if the tree is `NULL`.
+ */
+status displayPairTree(pair_tree tree);
+
+#endif
@@ -0,0 +1,153 @@
+#include "StringPool.h"
+#include "HashFunctions.h"
+#include <string.h>
+
+/** The number of bytes of strings a chunk holds, unless a longer string needs a chunk of its own. */
+#define CHUNK_SIZE 4096
+/** The number of slots of a new pool; the slots are always a power of two, at most half full. */
+#define INITIAL_SLOTS 64
+
+/**
+ * @brief A chunk: a header followed by the bytes of the strings stored in it.
+ */
+typedef struct string_chunk_rec {
+    struct string_chunk_rec *next;
+    size_t used;
+    size_t size;
+} string_chunk_rec, *string_chunk;
+
+struct string_pool_rec {
+    /**
+ * @brief Structure representing a string pool.
+ *
+ * - `slots` / `hashes`: An open addressing table of the canonical strings and their hashes,
+ *   probed linearly; empty slots hold `NULL`.
+ * - `chunks`: The chunks holding the strings, the newest first.
+ */
+    char **slots;
+    uint64_t *hashes;
+    int capacity;
+    int size;
+    string_chunk chunks;
+};
+
+static int find_slot(string_pool pool, char *str, uint64_t hash) {
+    /**
+ * @brief Probes for a string, returning the slot holding it or the empty slot where it belongs.
+ */
+    int mask = pool->capacity - 1;
+    int i = (int) (hash & mask);
+    while (pool->slots[i] != NULL && (pool->hashes[i] != hash || strcmp(pool->slots[i], str) != 0)) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+static bool grow_slots(string_pool pool) {
+    int capacity = pool->capacity * 2;
+    char **slots = (char **) calloc(capacity, sizeof(char *));
+    uint64_t *hashes = (uint64_t *) malloc(capacity * sizeof(uint64_t));
+    if (slots == NULL || hashes == NULL) {
+        free(slots);
+        free(hashes);
+        return false;
+    }
+    for (int i = 0; i < pool->capacity; i++) {
+        if (pool->slots[i] == NULL) continue;
+        int j = (int) (pool->hashes[i] & (capacity - 1));
+        while (slots[j] != NULL) j = (j + 1) & (capacity - 1);
+        slots[j] = pool->slots[i];
+        hashes[j] = pool->hashes[i];
+    }
+    free(pool->slots);
+    free(pool->hashes);
+    pool->slots = slots;
+    pool->hashes = hashes;
+    pool->capacity = capacity;
+    return true;
+}
+
+static char *store_string(string_pool pool, char *str) {
+    /**
+ * @brief Copies a string into the newest chunk, starting a new chunk when it does not fit.
+ */
+    size_t length = strlen(str) + 1;
+    string_chunk chunk = pool->chunks;
+    if (chunk == NULL || chunk->size - chunk->used < length) {
+        size_t size = length > CHUNK_SIZE ? length : CHUNK_SIZE;
+        chunk = (string_chunk) malloc(sizeof(string_chunk_rec) + size);
+        if (chunk == NULL) return NULL;
+        chunk->used = 0;
+        chunk->size = size;
+        //a string longer than a chunk gets a chunk of its own, behind the current one
+        if (size > CHUNK_SIZE && pool->chunks != NULL) {
+            chunk->next = pool->chunks->next;
+            pool->chunks->next = chunk;
+        } else {
+            chunk->next = pool->chunks;
+            pool->chunks = chunk;
+        }
+    }
+    char *copy = (char *) (chunk + 1) + chunk->used;
+    memcpy(copy, str, length);
+    chunk->used += length;
+    return copy;
+}
+
+string_pool createStringPool(void) {
+    string_pool newPool = (string_pool) malloc(sizeof(struct string_pool_rec));
+    if (newPool == NULL)
+        return NULL;
+    newPool->slots = (char **) calloc(INITIAL_SLOTS, sizeof(char *));
+    newPool->hashes = (uint64_t *) malloc(INITIAL_SLOTS * sizeof(uint64_t));
+    if (newPool->slots == NULL || newPool->hashes == NULL) {
+        free(newPool->slots);
+        free(newPool->hashes);
+        free(newPool);
+        return NULL;
+    }
+    newPool->capacity = INITIAL_SLOTS;
+    newPool->size = 0;
+    newPool->chunks = NULL;
+    return newPool;
+}
+
+char *internString(string_pool pool, char *str) {
+    if (pool == NULL || str == NULL) return NULL;
+    uint64_t hash = wyhashString(str, 0);
+    int i = find_slot(pool, str, hash);
+    if (pool->slots[i] != NULL) return pool->slots[i];
+    if ((pool->size + 1) * 2 > pool->capacity) {
+        if (!grow_slots(pool)) return NULL;
+        i = find_slot(pool, str, hash);
+    }
+    char *copy = store_string(pool, str);
+    if (copy == NULL) return NULL;
+    pool->slots[i] = copy;
+    pool->hashes[i] = hash;
+    pool->size++;
+    return copy;
+}
+
+char *findInternedString(string_pool pool, char *str) {
+    if (pool == NULL || str == NULL) return NULL;
+    return pool->slots[find_slot(pool, str, wyhashString(str, 0))];
+}
+
+int getStringPoolSize(string_pool pool) {
+    if (pool == NULL) return 0;
+    return pool->size;
+}
+
+void destroyStringPool(string_pool pool) {
+    if (pool == NULL) return;
+    string_chunk chunk = pool->chunks;
+    while (chunk != NULL) {
+        string_chunk next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    free(pool->slots);
+    free(pool->hashes);
+    free(pool);
+}
@@ -0,0 +1,61 @@
+#ifndef STRING_POOL_H
+#define STRING_POOL_H
+#include "Defs.h"
+
+typedef struct string_pool_rec* string_pool;
+
+/**
+ * @brief Creates an empty string pool, which interns strings.
+ *
+ * Interning a string returns the pool's canonical copy of it: every distinct string is stored
+ * once, however many times it is interned, and two interned strings are equal exactly when
+ * they are the same pointer. The copies are packed into large chunks, so a pool of short names
+ * costs few allocations. Interned strings stay valid until the pool is destroyed.
+ *
+ * @return
+ * - Pointer to the newly created pool if memory allocation is successful.
+ * - `NULL` if memory allocation fails.
+ */
+string_pool createStringPool(void);
+/**
+ * @brief Retrieves the canonical copy of a string, storing one first if the string is new.
+ *
+ * @param pool Pointer to the pool.
+ * @param str The string to intern.
+ *
+ * @return
+ * - The canonical copy of the string, owned by the pool. It must not be modified or freed.
+ * - `NULL` if the pool or the string is `NULL`, or memory allocation fails.
+ */
+char *internString(string_pool pool, char *str);
+/**
+ * @brief Retrieves the canonical copy of a string without storing it.
+ *
+ * @param pool Pointer to the pool.
+ * @param str The string to search for.
+ *
+ * @return
+ * - The canonical copy of the string, owned by the pool.
+ * - `NULL` if the pool or the string is `NULL`, or the string was never interned.
+ */
+char *findInternedString(string_pool pool, char *str);
+/**
+ * @brief Retrieves the number of distinct strings in the pool.
+ *
+ * @param pool Pointer to the pool.
+ *
+ * @return
+ * - The number of strings interned in the pool.
+ * - `0` if the pool is `NULL`.
+ */
+int getStringPoolSize(string_pool pool);
+/**
+ * @brief Frees a pool together with all its strings.
+ *
+ * @param pool Pointer to the pool. The function performs no operation if it is `NULL`.
+ *
+ * @return Void.
+ */
+void destroyStringPool(string_pool pool);
+
+#endif